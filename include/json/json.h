@@ -27,7 +27,28 @@ typedef void (*js_failed_fun_t)(const char * _pointer, const char * _end, const
 js_result_t js_parse( js_allocator_t _allocator, js_flags_t _flags, const char * _data, js_size_t _size, js_failed_fun_t _failed, void * _ud, js_element_t ** _documet );
 js_result_t js_clone( js_allocator_t _allocator, js_flags_t _flags, const js_element_t * _base, js_element_t ** _total );
 js_result_t js_patch( js_allocator_t _allocator, js_flags_t _flags, const js_element_t * _base, const js_element_t * _patch, js_element_t ** _total );
+js_result_t js_patch_inplace( js_element_t * _documet, const js_element_t * _patch );
+// js_diff emits an RFC 7386 merge patch, where null means "remove": a field whose new value is null
+// is emitted as "key":null, so applying the patch drops the field instead of storing the null.
+js_result_t js_diff( js_allocator_t _allocator, js_flags_t _flags, const js_element_t * _base, const js_element_t * _total, js_element_t ** _patch );
 js_result_t js_create( js_allocator_t _allocator, js_flags_t _flags, js_element_t ** _documet );
+js_result_t js_parse_into( js_element_t * _documet, const char * _data, js_size_t _size, js_failed_fun_t _failed, void * _ud );
+
+typedef enum js_parse_status_e
+{
+    js_parse_status_progress,
+    js_parse_status_done,
+    js_parse_status_failed,
+} js_parse_status_e;
+
+typedef uint32_t js_parse_status_t;
+
+typedef struct js_parser_t js_parser_t;
+
+js_result_t js_parser_create( js_allocator_t _allocator, js_flags_t _flags, const char * _data, js_size_t _size, js_failed_fun_t _failed, void * _ud, js_parser_t ** _parser );
+js_parse_status_t js_parse_step( js_parser_t * _parser, js_size_t _budget );
+js_element_t * js_parser_document( const js_parser_t * _parser );
+void js_parser_destroy( js_parser_t * _parser );
 
 js_result_t js_object_add_field_null( js_element_t * _documet, js_element_t * _element, js_string_t _key );
 js_result_t js_object_add_field_true( js_element_t * _documet, js_element_t * _element, js_string_t _key );
@@ -54,7 +75,24 @@ js_result_t js_array_push_object( js_element_t * _documet, js_element_t * _eleme
 void js_array_remove( js_element_t * _document, js_element_t * _element, js_size_t _index );
 void js_array_clear( js_element_t * _document, js_element_t * _element );
 
+js_element_t * js_array_detach( js_element_t * _document, js_element_t * _element, js_size_t _index );
+js_element_t * js_object_detach( js_element_t * _document, js_element_t * _element, const char * _key );
+js_result_t js_array_attach( js_element_t * _document, js_element_t * _element, js_element_t * _from, js_element_t * _value );
+js_result_t js_object_attach( js_element_t * _document, js_element_t * _element, js_string_t _key, js_element_t * _from, js_element_t * _value );
+js_result_t js_object_move( js_element_t * _document, js_element_t * _element, js_string_t _key, js_element_t * _from, js_element_t * _from_element, const char * _from_key );
+void js_discard( js_element_t * _document, js_element_t * _value );
+
 void js_free( js_element_t * _element );
+js_bool_t js_free_incremental( js_element_t * _element, js_size_t _budget );
+void js_reset( js_element_t * _element );
+
+typedef struct js_document_pool_t js_document_pool_t;
+
+js_result_t js_document_pool_create( js_allocator_t _allocator, js_flags_t _flags, js_document_pool_t ** _pool );
+void js_document_pool_destroy( js_document_pool_t * _pool );
+void js_document_pool_flush( js_document_pool_t * _pool );
+js_result_t js_document_pool_acquire( js_document_pool_t * _pool, js_element_t ** _documet );
+void js_document_pool_release( js_document_pool_t * _pool, js_element_t * _documet );
 
 js_type_t js_type( const js_element_t * _element );
 
@@ -72,6 +110,10 @@ js_bool_t js_get_boolean( const js_element_t * _element );
 js_integer_t js_get_integer( const js_element_t * _element );
 js_real_t js_get_real( const js_element_t * _element );
 void js_get_string( const js_element_t * _element, js_string_t * const _value );
+js_bool_t js_get_source( const js_element_t * _element, js_string_t * const _source );
+
+js_hash_t js_hash( const js_element_t * _element );
+js_bool_t js_equal( js_allocator_t _allocator, const js_element_t * _a, const js_element_t * _b );
 
 js_size_t js_array_size( const js_element_t * _element );
 js_element_t * js_array_get( const js_element_t * _element, js_size_t _index );
@@ -80,6 +122,9 @@ js_size_t js_object_size( const js_element_t * _element );
 js_element_t * js_object_get( const js_element_t * _element, const char * _key );
 js_element_t * js_object_getn( const js_element_t * _element, js_string_t _key );
 
+js_element_t * js_array_edit( js_element_t * _documet, js_element_t * _element, js_size_t _index );
+js_element_t * js_object_edit( js_element_t * _documet, js_element_t * _element, const char * _key );
+
 typedef js_result_t( *js_array_visitor_fun_t )(js_size_t _index, const js_element_t * _value, void * _ud);
 js_result_t js_array_visit( const js_element_t * _element, js_array_visitor_fun_t _visitor, void * _ud );
 
@@ -92,4 +137,14 @@ void js_array_foreach( const js_element_t * _element, js_array_foreach_fun_t _fo
 typedef void(*js_object_foreach_fun_t)(js_size_t _index, const js_element_t * _key, const js_element_t * _value, void * _ud);
 void js_object_foreach( const js_element_t * _element, js_object_foreach_fun_t _foreach, void * _ud );
 
+typedef struct js_iterator_t
+{
+    const void * key;
+    const void * value;
+} js_iterator_t;
+
+void js_array_begin( const js_element_t * _element, js_iterator_t * const _iterator );
+void js_object_begin( const js_element_t * _element, js_iterator_t * const _iterator );
+js_bool_t js_iterator_next( js_iterator_t * _iterator, const js_element_t ** _key, const js_element_t ** _value );
+
 #endif
\ No newline at end of file
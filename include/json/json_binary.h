@@ -7,6 +7,18 @@
 extern "C" {
 #endif
 
+    typedef enum js_binary_flags_e
+    {
+        js_binary_flag_none = 0,
+        js_binary_flag_skippable = 1 << 0,
+        js_binary_flag_table = 1 << 1,
+        js_binary_flag_compact = 1 << 2,
+        js_binary_flag_strings = 1 << 3,
+        js_binary_flag_string_values = 1 << 4,
+    } js_binary_flags_e;
+
+    typedef uint32_t js_binary_flags_t;
+
     typedef void (*js_binary_write_fun_t)(const void * _buffer, js_size_t _size, void * _ud);
 
     typedef struct js_binary_ctx_t
@@ -17,6 +29,56 @@ extern "C" {
 
     void js_binary( const js_element_t * _element, js_binary_ctx_t * _ctx );
 
+    typedef struct js_binary_ex_ctx_t
+    {
+        js_binary_write_fun_t write;
+        void * ud;
+        js_allocator_t allocator;
+        js_binary_flags_t flags;
+        void * stage;
+        js_size_t stage_capacity;
+        js_buffer_t * buffer;
+    } js_binary_ex_ctx_t;
+
+    void js_make_binary_ex_ctx_default( js_allocator_t _allocator, js_binary_write_fun_t _fun, void * _ud, js_binary_flags_t _flags, js_binary_ex_ctx_t * const _ctx );
+    void js_make_binary_ex_ctx_stage( js_allocator_t _allocator, js_binary_write_fun_t _fun, void * _ud, js_binary_flags_t _flags, void * _stage, js_size_t _capacity, js_binary_ex_ctx_t * const _ctx );
+    void js_make_binary_ex_ctx_buffer( js_allocator_t _allocator, js_buffer_t * _buffer, js_binary_flags_t _flags, js_binary_ex_ctx_t * const _ctx );
+
+    js_result_t js_binary_ex( const js_element_t * _element, js_binary_ex_ctx_t * _ctx );
+
+    js_result_t js_binary_load( js_allocator_t _allocator, js_flags_t _flags, const void * _data, js_size_t _size, js_element_t ** _document );
+
+    typedef struct js_binary_view_t
+    {
+        const uint8_t * data;
+        const uint8_t * end;
+        const uint8_t * strings;
+        js_size_t strings_count;
+        js_binary_flags_t flags;
+    } js_binary_view_t;
+
+    js_result_t js_binary_view( const void * _data, js_size_t _size, js_binary_view_t * const _view );
+
+    js_type_t js_binary_view_type( const js_binary_view_t * _view );
+
+    js_bool_t js_binary_view_get_boolean( const js_binary_view_t * _view );
+    js_integer_t js_binary_view_get_integer( const js_binary_view_t * _view );
+    js_real_t js_binary_view_get_real( const js_binary_view_t * _view );
+    void js_binary_view_get_string( const js_binary_view_t * _view, js_string_t * const _value );
+
+    js_size_t js_binary_view_array_size( const js_binary_view_t * _view );
+    js_result_t js_binary_view_array_get( const js_binary_view_t * _view, js_size_t _index, js_binary_view_t * const _value );
+
+    js_size_t js_binary_view_object_size( const js_binary_view_t * _view );
+    js_result_t js_binary_view_object_get( const js_binary_view_t * _view, const char * _key, js_binary_view_t * const _value );
+    js_result_t js_binary_view_object_getn( const js_binary_view_t * _view, js_string_t _key, js_binary_view_t * const _value );
+
+    typedef void(*js_binary_view_array_foreach_fun_t)(js_size_t _index, const js_binary_view_t * _value, void * _ud);
+    js_result_t js_binary_view_array_foreach( const js_binary_view_t * _view, js_binary_view_array_foreach_fun_t _foreach, void * _ud );
+
+    typedef void(*js_binary_view_object_foreach_fun_t)(js_size_t _index, js_string_t _key, const js_binary_view_t * _value, void * _ud);
+    js_result_t js_binary_view_object_foreach( const js_binary_view_t * _view, js_binary_view_object_foreach_fun_t _foreach, void * _ud );
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@ typedef size_t js_size_t;
 
 typedef int64_t js_integer_t;
 typedef double js_real_t;
+typedef uint32_t js_hash_t;
 
 typedef struct js_string_t
 {
@@ -79,6 +80,14 @@ typedef struct js_string_t
 #   endif
 #endif
 
+#ifndef JS_SIMD_SSE2_ENABLE
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define JS_SIMD_SSE2_ENABLE 1
+#   else
+#       define JS_SIMD_SSE2_ENABLE 0
+#   endif
+#endif
+
 typedef enum js_type_e
 {
     js_type_null = 0,
@@ -98,6 +107,11 @@ typedef enum js_flags_e
     js_flag_none = 0,
     js_flag_string_inplace = 1 << 0,
     js_flag_node_pool = 1 << 1,
+    js_flag_source_span = 1 << 2,
+    js_flag_shared = 1 << 3,
+    js_flag_compact = 1 << 4,
+    js_flag_arena = 1 << 5,
+    js_flag_hash_cache = 1 << 6,
 } js_flags_e;
 
 typedef uint32_t js_flags_t;
@@ -1,7 +1,7 @@
 #ifndef JSON_DUMP_H_
 #define JSON_DUMP_H_
 
-#include "json/json_config.h"
+#include "json/json.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -13,15 +13,90 @@ extern "C" {
     {
         js_dump_buffer_fun_t buffer;
         void * ud;
+        int32_t precision;
     } js_dump_ctx_t;
 
     void js_make_dump_ctx_buffer( js_buffer_t * _buffer, js_dump_ctx_t * const _ctx );
     void js_make_dump_ctx_default( js_dump_buffer_fun_t _fun, void * _ud, js_dump_ctx_t * const _ctx );
+    void js_set_dump_ctx_precision( int32_t _precision, js_dump_ctx_t * const _ctx );
 
     js_result_t js_dump( const js_element_t * _element, js_dump_ctx_t * _ctx );
 
+    void js_dump_measure( const js_element_t * _element, js_size_t * const _size );
+    js_result_t js_dump_alloc( const js_element_t * _element, js_allocator_t _allocator, char ** const _buffer, js_size_t * const _size );
+
     js_result_t js_dump_string( js_string_t _value, char * const _buffer, js_size_t _capacity, js_size_t * const _size );
 
+#ifndef JS_DUMP_IOVEC_REFERENCE_SIZE
+#define JS_DUMP_IOVEC_REFERENCE_SIZE 64
+#endif
+
+    typedef struct js_iovec_t
+    {
+        const void * base;
+        js_size_t size;
+    } js_iovec_t;
+
+    js_result_t js_dump_iovec( const js_element_t * _element, char * const _scratch, js_size_t _scratch_capacity, js_iovec_t * const _iovecs, js_size_t _iovec_capacity, js_size_t * const _iovec_count );
+
+#ifndef JS_WRITER_MAX_DEPTH
+#define JS_WRITER_MAX_DEPTH 64
+#endif
+
+    typedef struct js_writer_t
+    {
+        js_dump_ctx_t * ctx;
+        uint32_t depth;
+        js_bool_t first;
+        js_bool_t key;
+        js_bool_t failed;
+        uint8_t stack[JS_WRITER_MAX_DEPTH];
+    } js_writer_t;
+
+    void js_make_writer( js_dump_ctx_t * _ctx, js_writer_t * const _writer );
+
+    js_result_t js_write_object_begin( js_writer_t * _writer );
+    js_result_t js_write_object_end( js_writer_t * _writer );
+    js_result_t js_write_array_begin( js_writer_t * _writer );
+    js_result_t js_write_array_end( js_writer_t * _writer );
+
+    js_result_t js_write_key( js_writer_t * _writer, const char * _key );
+    js_result_t js_write_keyn( js_writer_t * _writer, js_string_t _key );
+
+    js_result_t js_write_null( js_writer_t * _writer );
+    js_result_t js_write_boolean( js_writer_t * _writer, js_bool_t _value );
+    js_result_t js_write_integer( js_writer_t * _writer, js_integer_t _value );
+    js_result_t js_write_real( js_writer_t * _writer, js_real_t _value );
+    js_result_t js_write_string( js_writer_t * _writer, const char * _value );
+    js_result_t js_write_stringn( js_writer_t * _writer, js_string_t _value );
+    js_result_t js_write_element( js_writer_t * _writer, const js_element_t * _element );
+
+    js_result_t js_write_finish( js_writer_t * _writer );
+
+    typedef struct js_dump_chunk_t
+    {
+        const js_element_t * container;
+        const js_element_t * key;
+        js_size_t field;
+        js_size_t begin;
+        js_size_t end;
+        js_iterator_t iterator;
+        js_bool_t first;
+        js_bool_t last;
+        js_allocator_t allocator;
+        char * buffer;
+        js_size_t size;
+        js_result_t result;
+    } js_dump_chunk_t;
+
+    typedef void (*js_dump_parallel_fun_t)(js_dump_chunk_t * _chunks, js_size_t _count, void * _ud);
+
+    js_result_t js_dump_chunk( js_dump_chunk_t * _chunk );
+
+    js_result_t js_dump_parallel( const js_element_t * _element, js_allocator_t _allocator, js_size_t _concurrency, js_dump_parallel_fun_t _fun, void * _ud, js_dump_chunk_t ** const _chunks, js_size_t * const _count );
+    js_result_t js_dump_chunks_concat( const js_dump_chunk_t * _chunks, js_size_t _count, js_dump_ctx_t * _ctx );
+    void js_dump_chunks_free( js_allocator_t _allocator, js_dump_chunk_t * _chunks, js_size_t _count );
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,12 +1,37 @@
 #include "json/json.h"
 
 #include "json_assert.h"
+#include "json_atomic.h"
 #include "json_string.h"
 
 #ifndef JS_NODEBLOCK_SIZE
 #define JS_NODEBLOCK_SIZE 64
 #endif
 
+#ifndef JS_DOCUMENT_POOL_CACHE_SIZE
+#define JS_DOCUMENT_POOL_CACHE_SIZE 4
+#endif
+
+#ifndef JS_DOCUMENT_POOL_LOCAL_SIZE
+#define JS_DOCUMENT_POOL_LOCAL_SIZE 4
+#endif
+
+#ifndef JS_MEMORY_ALIGN
+#define JS_MEMORY_ALIGN 8
+#endif
+
+#ifndef JS_PARSER_STACK_SIZE
+#define JS_PARSER_STACK_SIZE 16
+#endif
+
+#ifndef JS_ARENA_CHUNK_SIZE
+#define JS_ARENA_CHUNK_SIZE 16384
+#endif
+
+#ifndef JS_PATCH_HASH_STACK_SIZE
+#define JS_PATCH_HASH_STACK_SIZE 32
+#endif
+
 #if JS_ALLOCATOR_MEMORY_CHECK_ENABLE
 #   define JS_ALLOCATOR_MEMORY_CHECK(Ptr, Ret) if( (Ptr) == JS_NULLPTR ) return (Ret);
 #else
@@ -16,6 +41,8 @@
 #define JS_ALLOCATOR_NEW(Allocator, Type) ((Type *)(Allocator)->alloc( sizeof( Type ), (Allocator)->ud ))
 #define JS_ALLOCATOR_NEW_EX(Allocator, Type, ExSize) ((Type *)(Allocator)->alloc( sizeof( Type ) + (ExSize), (Allocator)->ud ))
 
+#define JS_META_FLAGS (js_flag_source_span | js_flag_shared | js_flag_hash_cache)
+
 //////////////////////////////////////////////////////////////////////////
 typedef struct js_element_t
 {
@@ -77,24 +104,51 @@ typedef struct js_block_t
     struct js_block_t * prev;
 } js_block_t;
 //////////////////////////////////////////////////////////////////////////
+typedef struct js_element_meta_t
+{
+    js_element_t * parent;
+    js_string_t source;
+    js_size_t refcount;
+    js_hash_t hash;
+    js_bool_t hashed;
+} js_element_meta_t;
+//////////////////////////////////////////////////////////////////////////
 typedef struct js_element_object_t
 {
     js_element_t base;
+    js_bool_t meta;
     js_size_t size;
     js_node_t * keys;
     js_node_t * values;
+    js_node_t * keys_last;
+    js_node_t * values_last;
 } js_element_object_t;
 //////////////////////////////////////////////////////////////////////////
 typedef struct js_element_array_t
 {
     js_element_t base;
+    js_bool_t meta;
     js_size_t size;
     js_node_t * values;
+    js_node_t * values_last;
 } js_element_array_t;
 //////////////////////////////////////////////////////////////////////////
+typedef struct js_element_object_ex_t
+{
+    js_element_object_t object;
+    js_element_meta_t meta;
+} js_element_object_ex_t;
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_element_array_ex_t
+{
+    js_element_array_t array;
+    js_element_meta_t meta;
+} js_element_array_ex_t;
+//////////////////////////////////////////////////////////////////////////
 typedef struct js_document_t
 {
     js_element_object_t object;
+    js_element_meta_t meta;
     js_allocator_t allocator;
     js_flags_t flags;
 
@@ -105,6 +159,10 @@ typedef struct js_document_t
 
     js_node_t * free_node;
     js_block_t * free_block;
+
+    struct js_document_t * pool_next;
+
+    js_node_t * free_top;
 } js_document_t;
 //////////////////////////////////////////////////////////////////////////
 #define JS_ASSERT_CAST_DECLARE(Type, E) \
@@ -327,35 +385,232 @@ static js_element_string_t * __js_string_create_inplace( js_allocator_t * _alloc
     return string;
 }
 //////////////////////////////////////////////////////////////////////////
-static js_element_object_t * __js_object_create( js_allocator_t * _allocator )
+static void __js_meta_init( js_element_meta_t * _meta )
+{
+    _meta->parent = JS_NULLPTR;
+    _meta->source.value = JS_NULLPTR;
+    _meta->source.size = 0;
+    _meta->refcount = 1;
+    _meta->hash = 0;
+    _meta->hashed = JS_FALSE;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_element_object_t * __js_object_create( js_document_t * _document )
 {
-    js_element_object_t * object = JS_ALLOCATOR_NEW( _allocator, js_element_object_t );
+    js_allocator_t * allocator = __js_document_allocator( _document );
+
+    js_element_object_t * object;
+
+    if( _document->flags & JS_META_FLAGS )
+    {
+        js_element_object_ex_t * object_ex = JS_ALLOCATOR_NEW( allocator, js_element_object_ex_t );
+
+        JS_ALLOCATOR_MEMORY_CHECK( object_ex, JS_NULLPTR );
+
+        __js_meta_init( &object_ex->meta );
+
+        object = &object_ex->object;
+        object->meta = JS_TRUE;
+    }
+    else
+    {
+        object = JS_ALLOCATOR_NEW( allocator, js_element_object_t );
+
+        JS_ALLOCATOR_MEMORY_CHECK( object, JS_NULLPTR );
 
-    JS_ALLOCATOR_MEMORY_CHECK( object, JS_NULLPTR );
+        object->meta = JS_FALSE;
+    }
 
     object->base.type = js_type_object;
 
     object->size = 0;
     object->keys = JS_NULLPTR;
     object->values = JS_NULLPTR;
+    object->keys_last = JS_NULLPTR;
+    object->values_last = JS_NULLPTR;
 
     return object;
 }
 //////////////////////////////////////////////////////////////////////////
-static js_element_array_t * __js_array_create( js_allocator_t * _allocator )
+static js_element_array_t * __js_array_create( js_document_t * _document )
 {
-    js_element_array_t * array = JS_ALLOCATOR_NEW( _allocator, js_element_array_t );
+    js_allocator_t * allocator = __js_document_allocator( _document );
+
+    js_element_array_t * array;
+
+    if( _document->flags & JS_META_FLAGS )
+    {
+        js_element_array_ex_t * array_ex = JS_ALLOCATOR_NEW( allocator, js_element_array_ex_t );
+
+        JS_ALLOCATOR_MEMORY_CHECK( array_ex, JS_NULLPTR );
+
+        __js_meta_init( &array_ex->meta );
+
+        array = &array_ex->array;
+        array->meta = JS_TRUE;
+    }
+    else
+    {
+        array = JS_ALLOCATOR_NEW( allocator, js_element_array_t );
+
+        JS_ALLOCATOR_MEMORY_CHECK( array, JS_NULLPTR );
 
-    JS_ALLOCATOR_MEMORY_CHECK( array, JS_NULLPTR );
+        array->meta = JS_FALSE;
+    }
 
     array->base.type = js_type_array;
 
     array->size = 0;
     array->values = JS_NULLPTR;
+    array->values_last = JS_NULLPTR;
 
     return array;
 }
 //////////////////////////////////////////////////////////////////////////
+static js_element_meta_t * __js_element_meta( const js_element_t * _element )
+{
+    js_type_t type = js_type( _element );
+
+    if( type == js_type_object )
+    {
+        js_element_object_t * object = JS_CAST( js_element_object_t, (js_element_t *)_element );
+
+        if( object->meta == JS_FALSE )
+        {
+            return JS_NULLPTR;
+        }
+
+        js_element_object_ex_t * object_ex = (js_element_object_ex_t *)object;
+
+        return &object_ex->meta;
+    }
+    else if( type == js_type_array )
+    {
+        js_element_array_t * array = JS_CAST( js_element_array_t, (js_element_t *)_element );
+
+        if( array->meta == JS_FALSE )
+        {
+            return JS_NULLPTR;
+        }
+
+        js_element_array_ex_t * array_ex = (js_element_array_ex_t *)array;
+
+        return &array_ex->meta;
+    }
+
+    return JS_NULLPTR;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_element_touch( js_element_t * _element )
+{
+    for( js_element_t * it = _element; it != JS_NULLPTR; )
+    {
+        js_element_meta_t * meta = __js_element_meta( it );
+
+        if( meta == JS_NULLPTR )
+        {
+            break;
+        }
+
+        if( meta->source.value == JS_NULLPTR && meta->hashed == JS_FALSE )
+        {
+            break;
+        }
+
+        meta->source.value = JS_NULLPTR;
+        meta->source.size = 0;
+        meta->hashed = JS_FALSE;
+
+        it = meta->parent;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_element_set_parent( js_element_t * _element, js_element_t * _parent )
+{
+    js_element_meta_t * meta = __js_element_meta( _element );
+
+    if( meta == JS_NULLPTR )
+    {
+        return;
+    }
+
+    meta->parent = _parent;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_element_set_source( js_element_t * _element, const char * _begin, const char * _end )
+{
+    js_element_meta_t * meta = __js_element_meta( _element );
+
+    if( meta == JS_NULLPTR )
+    {
+        return;
+    }
+
+    meta->source.value = _begin;
+    meta->source.size = _end - _begin;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_element_refcount( const js_element_t * _element )
+{
+    const js_element_meta_t * meta = __js_element_meta( _element );
+
+    if( meta == JS_NULLPTR )
+    {
+        return 1;
+    }
+
+    return meta->refcount;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_element_release( js_element_t * _element )
+{
+    js_element_meta_t * meta = __js_element_meta( _element );
+
+    if( meta == JS_NULLPTR )
+    {
+        return 0;
+    }
+
+    js_size_t refcount = --meta->refcount;
+
+    return refcount;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_element_t * __js_element_parent( const js_element_t * _element )
+{
+    const js_element_meta_t * meta = __js_element_meta( _element );
+
+    if( meta == JS_NULLPTR )
+    {
+        return JS_NULLPTR;
+    }
+
+    return meta->parent;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_element_writable( js_document_t * _document, js_element_t * _element )
+{
+    if( (_document->flags & js_flag_shared) == 0 )
+    {
+        return JS_TRUE;
+    }
+
+    for( js_element_t * it = _element; it != JS_NULLPTR; it = __js_element_parent( it ) )
+    {
+        if( it == (js_element_t *)_document )
+        {
+            return JS_TRUE;
+        }
+
+        if( __js_element_refcount( it ) != 1 )
+        {
+            return JS_FALSE;
+        }
+    }
+
+    return JS_FALSE;
+}
+//////////////////////////////////////////////////////////////////////////
 static js_block_t * __js_block_create( js_allocator_t * _allocator, js_node_t ** _free )
 {
     js_block_t * block = JS_ALLOCATOR_NEW( _allocator, js_block_t );
@@ -434,6 +689,43 @@ static void __js_node_destroy( js_document_t * _document, js_node_t * _node )
     _document->node_destroy( _document, _node );
 }
 //////////////////////////////////////////////////////////////////////////
+static void __js_element_orphan( js_element_t * _element, const js_element_t * _holder )
+{
+    js_element_meta_t * meta = __js_element_meta( _element );
+
+    if( meta == JS_NULLPTR )
+    {
+        return;
+    }
+
+    if( meta->parent == _holder )
+    {
+        meta->parent = JS_NULLPTR;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_element_detach( js_element_t * _element, const js_element_t * _holder, js_element_t * _document )
+{
+    js_element_meta_t * meta = __js_element_meta( _element );
+
+    if( meta == JS_NULLPTR )
+    {
+        return;
+    }
+
+    if( meta->parent == _holder )
+    {
+        meta->parent = _document;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_node_release( js_document_t * _document, const js_element_t * _holder, js_node_t * _node )
+{
+    __js_element_orphan( _node->element, _holder );
+
+    __js_node_destroy( _document, _node );
+}
+//////////////////////////////////////////////////////////////////////////
 static void __js_element_destroy( js_document_t * _document, js_element_t * _element );
 static void __js_array_destroy( js_document_t * _document, js_element_array_t * _array );
 static void __js_object_destroy( js_document_t * _document, js_element_object_t * _object );
@@ -505,6 +797,11 @@ static void __js_element_destroy( js_document_t * _document, js_element_t * _ele
 //////////////////////////////////////////////////////////////////////////
 static void __js_array_destroy( js_document_t * _document, js_element_array_t * _array )
 {
+    if( __js_element_release( (js_element_t *)_array ) != 0 )
+    {
+        return;
+    }
+
     js_node_t * it_node = _array->values;
 
     for( ; it_node != JS_NULLPTR; )
@@ -513,7 +810,7 @@ static void __js_array_destroy( js_document_t * _document, js_element_array_t *
 
         it_node = it_node->next;
 
-        __js_node_destroy( _document, free_node );
+        __js_node_release( _document, (js_element_t *)_array, free_node );
     }
 
     js_allocator_t * allocator = __js_document_allocator( _document );
@@ -523,6 +820,11 @@ static void __js_array_destroy( js_document_t * _document, js_element_array_t *
 //////////////////////////////////////////////////////////////////////////
 static void __js_object_destroy( js_document_t * _document, js_element_object_t * _object )
 {
+    if( __js_element_release( (js_element_t *)_object ) != 0 )
+    {
+        return;
+    }
+
     js_node_t * it_key = _object->keys;
     js_node_t * it_value = _object->values;
 
@@ -535,7 +837,7 @@ static void __js_object_destroy( js_document_t * _document, js_element_object_t
         it_value = it_value->next;
 
         __js_node_destroy( _document, free_key );
-        __js_node_destroy( _document, free_value );
+        __js_node_release( _document, (js_element_t *)_object, free_value );
     }
 
     js_allocator_t * allocator = __js_document_allocator( _document );
@@ -561,8 +863,143 @@ static void __js_node_destroy_allocator( js_document_t * _document, js_node_t *
     allocator->free( _node, allocator->ud );
 }
 //////////////////////////////////////////////////////////////////////////
+static js_size_t __js_memory_align( js_size_t _size )
+{
+    js_size_t size = (_size + JS_MEMORY_ALIGN - 1) & ~(js_size_t)(JS_MEMORY_ALIGN - 1);
+
+    return size;
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_chunk_t
+{
+    struct js_chunk_t * next;
+    uint8_t * end;
+} js_chunk_t;
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_arena_t
+{
+    js_allocator_t origin;
+
+    js_chunk_t * first;
+    js_chunk_t * current;
+    uint8_t * memory;
+} js_arena_t;
+//////////////////////////////////////////////////////////////////////////
+static uint8_t * __js_chunk_begin( js_chunk_t * _chunk )
+{
+    uint8_t * begin = (uint8_t *)_chunk + __js_memory_align( sizeof( js_chunk_t ) );
+
+    return begin;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_chunk_t * __js_chunk_create( js_allocator_t * _allocator, js_size_t _size )
+{
+    js_size_t capacity = __js_memory_align( sizeof( js_chunk_t ) ) + _size;
+
+    if( capacity < JS_ARENA_CHUNK_SIZE )
+    {
+        capacity = JS_ARENA_CHUNK_SIZE;
+    }
+
+    js_chunk_t * chunk = (js_chunk_t *)_allocator->alloc( capacity, _allocator->ud );
+
+    JS_ALLOCATOR_MEMORY_CHECK( chunk, JS_NULLPTR );
+
+    chunk->next = JS_NULLPTR;
+    chunk->end = (uint8_t *)chunk + capacity;
+
+    return chunk;
+}
+//////////////////////////////////////////////////////////////////////////
+static void * __js_arena_alloc( js_size_t _size, void * _ud )
+{
+    js_arena_t * arena = (js_arena_t *)_ud;
+
+    js_size_t size = __js_memory_align( _size );
+
+    if( arena->memory + size > arena->current->end )
+    {
+        js_chunk_t * next = arena->current->next;
+
+        if( next == JS_NULLPTR || __js_chunk_begin( next ) + size > next->end )
+        {
+            next = __js_chunk_create( &arena->origin, size );
+
+            JS_ALLOCATOR_MEMORY_CHECK( next, JS_NULLPTR );
+
+            next->next = arena->current->next;
+            arena->current->next = next;
+        }
+
+        arena->current = next;
+        arena->memory = __js_chunk_begin( next );
+    }
+
+    void * alloc_memory = arena->memory;
+
+    arena->memory += size;
+
+    return alloc_memory;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_arena_free( void * _ptr, void * _ud )
+{
+    JS_UNUSED( _ptr );
+    JS_UNUSED( _ud );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_arena_create( js_allocator_t _allocator, js_allocator_t * const _arena )
+{
+    js_chunk_t * chunk = __js_chunk_create( &_allocator, __js_memory_align( sizeof( js_arena_t ) ) );
+
+    JS_ALLOCATOR_MEMORY_CHECK( chunk, JS_FAILURE );
+
+    js_arena_t * arena = (js_arena_t *)__js_chunk_begin( chunk );
+
+    arena->origin = _allocator;
+    arena->first = chunk;
+    arena->current = chunk;
+    arena->memory = (uint8_t *)arena + __js_memory_align( sizeof( js_arena_t ) );
+
+    _arena->alloc = &__js_arena_alloc;
+    _arena->free = &__js_arena_free;
+    _arena->ud = arena;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_arena_destroy( js_arena_t * _arena )
+{
+    js_allocator_t origin = _arena->origin;
+
+    for( js_chunk_t * chunk = _arena->first; chunk != JS_NULLPTR; )
+    {
+        js_chunk_t * free_chunk = chunk;
+
+        chunk = chunk->next;
+
+        origin.free( free_chunk, origin.ud );
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_arena_rewind( js_arena_t * _arena, const js_document_t * _document )
+{
+    _arena->current = _arena->first;
+    _arena->memory = (uint8_t *)_document + __js_memory_align( sizeof( js_document_t ) );
+}
+//////////////////////////////////////////////////////////////////////////
 static js_document_t * __js_document_create( js_allocator_t _allocator, js_flags_t _flags )
 {
+    if( _flags & js_flag_arena )
+    {
+        if( __js_arena_create( _allocator, &_allocator ) == JS_FAILURE )
+        {
+            return JS_NULLPTR;
+        }
+
+        _flags &= ~(js_flags_t)js_flag_node_pool;
+    }
+
     js_document_t * document = (js_document_t *)_allocator.alloc( sizeof( js_document_t ), _allocator.ud );
 
     JS_ALLOCATOR_MEMORY_CHECK( document, JS_NULLPTR );
@@ -572,6 +1009,11 @@ static js_document_t * __js_document_create( js_allocator_t _allocator, js_flags
     document->object.size = 0;
     document->object.keys = JS_NULLPTR;
     document->object.values = JS_NULLPTR;
+    document->object.keys_last = JS_NULLPTR;
+    document->object.values_last = JS_NULLPTR;
+    document->object.meta = (_flags & JS_META_FLAGS) != 0 ? JS_TRUE : JS_FALSE;
+
+    __js_meta_init( &document->meta );
 
     document->allocator = _allocator;
     document->flags = _flags;
@@ -587,6 +1029,9 @@ static js_document_t * __js_document_create( js_allocator_t _allocator, js_flags
     {
         document->node_create = &__js_node_create_allocator;
         document->node_destroy = &__js_node_destroy_allocator;
+
+        document->free_node = JS_NULLPTR;
+        document->free_block = JS_NULLPTR;
     }
 
     if( _flags & js_flag_string_inplace )
@@ -600,17 +1045,33 @@ static js_document_t * __js_document_create( js_allocator_t _allocator, js_flags
         document->string_destroy = &__js_string_destroy_allocator;
     }
 
+    document->pool_next = JS_NULLPTR;
+    document->free_top = JS_NULLPTR;
+
     return document;
 }
 //////////////////////////////////////////////////////////////////////////
-static void __js_element_node_add( js_node_t ** _root, js_node_t * _node )
+static void __js_element_node_add( js_node_t ** _root, js_node_t ** _last, js_node_t * _node )
 {
-    _node->next = (*_root);
-    (*_root) = _node;
+    _node->next = JS_NULLPTR;
+
+    if( (*_last) == JS_NULLPTR )
+    {
+        (*_root) = _node;
+    }
+    else
+    {
+        (*_last)->next = _node;
+    }
+
+    (*_last) = _node;
 }
 //////////////////////////////////////////////////////////////////////////
 static js_result_t __js_object_add( js_document_t * _document, js_element_t * _object, js_element_string_t * _key, js_element_t * _value )
 {
+    __js_element_touch( _object );
+    __js_element_set_parent( _value, _object );
+
     js_element_object_t * object = JS_CAST( js_element_object_t, _object );
 
     ++object->size;
@@ -623,14 +1084,21 @@ static js_result_t __js_object_add( js_document_t * _document, js_element_t * _o
 
     JS_ALLOCATOR_MEMORY_CHECK( value_node, JS_FAILURE );
 
-    __js_element_node_add( &object->keys, key_node );
-    __js_element_node_add( &object->values, value_node );
+    __js_element_node_add( &object->keys, &object->keys_last, key_node );
+    __js_element_node_add( &object->values, &object->values_last, value_node );
 
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
 static js_result_t __js_object_add_string( js_document_t * _document, js_element_t * _object, js_string_t _key, js_element_t * _value )
 {
+    if( __js_element_writable( _document, _object ) == JS_FALSE )
+    {
+        __js_element_destroy( _document, _value );
+
+        return JS_FAILURE;
+    }
+
     js_element_string_t * key = _document->string_create( __js_document_allocator( _document ), _key );
 
     JS_ALLOCATOR_MEMORY_CHECK( key, JS_FAILURE );
@@ -642,6 +1110,9 @@ static js_result_t __js_object_add_string( js_document_t * _document, js_element
 //////////////////////////////////////////////////////////////////////////
 static js_result_t __js_array_add( js_document_t * _document, js_element_t * _array, js_element_t * _value )
 {
+    __js_element_touch( _array );
+    __js_element_set_parent( _value, _array );
+
     js_element_array_t * array = JS_CAST( js_element_array_t, _array );
 
     ++array->size;
@@ -653,16 +1124,30 @@ static js_result_t __js_array_add( js_document_t * _document, js_element_t * _ar
         return JS_FAILURE;
     }
 
-    __js_element_node_add( &array->values, value_node );
+    __js_element_node_add( &array->values, &array->values_last, value_node );
 
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-static js_result_t __js_parse_element( js_document_t * _document, const char ** _data, const char * _end, char _token, js_failed_fun_t _failed, void * _ud, js_element_t ** _element );
-static js_result_t __js_parse_array( js_document_t * _document, const char ** _data, const char * _end, js_failed_fun_t _failed, void * _ud, js_element_t * _array );
+static js_result_t __js_array_push( js_document_t * _document, js_element_t * _array, js_element_t * _value )
+{
+    if( __js_element_writable( _document, _array ) == JS_FALSE )
+    {
+        __js_element_destroy( _document, _value );
+
+        return JS_FAILURE;
+    }
+
+    js_result_t result = __js_array_add( _document, _array, _value );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_parse_element( js_document_t * _document, const char ** _data, const char * _end, char _token, js_bool_t _open, js_failed_fun_t _failed, void * _ud, js_element_t ** _element );
+static js_result_t __js_parse_array( js_document_t * _document, const char ** _data, const char * _end, js_failed_fun_t _failed, void * _ud, js_element_t * _array );
 static js_result_t __js_parse_object( js_document_t * _document, const char ** _data, const char * _end, js_failed_fun_t _failed, void * _ud, js_element_t * _object );
 //////////////////////////////////////////////////////////////////////////
-static js_result_t __js_parse_element( js_document_t * _document, const char ** _data, const char * _end, char _token, js_failed_fun_t _failed, void * _ud, js_element_t ** _element )
+static js_result_t __js_parse_element( js_document_t * _document, const char ** _data, const char * _end, char _token, js_bool_t _open, js_failed_fun_t _failed, void * _ud, js_element_t ** _element )
 {
     js_allocator_t * allocator = __js_document_allocator( _document );
 
@@ -798,15 +1283,29 @@ static js_result_t __js_parse_element( js_document_t * _document, const char **
     {
         const char * data_iterator = data_soa;
 
-        js_element_object_t * object = __js_object_create( allocator );
+        js_element_object_t * object = __js_object_create( _document );
 
         JS_ALLOCATOR_MEMORY_CHECK( object, JS_FAILURE );
 
+        if( _open == JS_TRUE )
+        {
+            *_element = (js_element_t *)object;
+
+            *_data = data_soa;
+
+            return JS_SUCCESSFUL;
+        }
+
         if( __js_parse_object( _document, &data_iterator, _end, _failed, _ud, (js_element_t *)object ) == JS_FAILURE )
         {
             return JS_FAILURE;
         }
 
+        if( _document->flags & js_flag_source_span )
+        {
+            __js_element_set_source( (js_element_t *)object, data_soa, data_iterator );
+        }
+
         *_element = (js_element_t *)object;
 
         *_data = data_iterator;
@@ -817,15 +1316,29 @@ static js_result_t __js_parse_element( js_document_t * _document, const char **
     {
         const char * data_iterator = data_soa;
 
-        js_element_array_t * array = __js_array_create( allocator );
+        js_element_array_t * array = __js_array_create( _document );
 
         JS_ALLOCATOR_MEMORY_CHECK( array, JS_FAILURE );
 
+        if( _open == JS_TRUE )
+        {
+            *_element = (js_element_t *)array;
+
+            *_data = data_soa;
+
+            return JS_SUCCESSFUL;
+        }
+
         if( __js_parse_array( _document, &data_iterator, _end, _failed, _ud, (js_element_t *)array ) == JS_FAILURE )
         {
             return JS_FAILURE;
         }
 
+        if( _document->flags & js_flag_source_span )
+        {
+            __js_element_set_source( (js_element_t *)array, data_soa, data_iterator );
+        }
+
         *_element = (js_element_t *)array;
 
         *_data = data_iterator;
@@ -858,7 +1371,7 @@ static js_result_t __js_parse_array( js_document_t * _document, const char ** _d
     for( ;; )
     {
         js_element_t * value;
-        if( __js_parse_element( _document, &data_iterator, _end, ']', _failed, _ud, &value ) == JS_FAILURE )
+        if( __js_parse_element( _document, &data_iterator, _end, ']', JS_FALSE, _failed, _ud, &value ) == JS_FAILURE )
         {
             return JS_FAILURE;
         }
@@ -883,65 +1396,82 @@ static js_result_t __js_parse_array( js_document_t * _document, const char ** _d
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-static js_result_t __js_parse_object( js_document_t * _document, const char ** _data, const char * _end, js_failed_fun_t _failed, void * _ud, js_element_t * _object )
+static js_result_t __js_parse_key( js_document_t * _document, const char ** _data, const char * _end, js_failed_fun_t _failed, void * _ud, js_element_string_t ** _key )
 {
     js_allocator_t * allocator = __js_document_allocator( _document );
 
-    const char * data_begin = *_data;
-    const char * data_iterator = data_begin + 1;
+    const char * data_iterator = *_data;
 
-    const char * value_empty = js_strskip( data_iterator, _end, " \t\n\r" );
+    const char * key_begin = js_strchr( data_iterator, _end, '"' );
 
-    if( value_empty != JS_NULLPTR && *value_empty == '}' )
+    if( key_begin == JS_NULLPTR )
     {
-        *_data = value_empty + 1;
+        _failed( data_iterator, _end, "parse object [key begin]", _ud );
 
-        return JS_SUCCESSFUL;
+        return JS_FAILURE;
     }
 
-    data_iterator = value_empty;
+    const char * key_end = js_strchr( key_begin + 1, _end, '"' );
 
-    for( ;; )
+    if( key_end == JS_NULLPTR )
     {
-        const char * key_begin = js_strchr( data_iterator, _end, '"' );
+        _failed( key_begin + 1, _end, "parse object [key end]", _ud );
 
-        if( key_begin == JS_NULLPTR )
-        {
-            _failed( data_iterator, _end, "parse object [key begin]", _ud );
+        return JS_FAILURE;
+    }
 
-            return JS_FAILURE;
-        }
+    js_size_t key_size = key_end - key_begin;
 
-        const char * key_end = js_strchr( key_begin + 1, _end, '"' );
+    js_string_t key_string = {key_begin + 1, key_size - 1};
 
-        if( key_end == JS_NULLPTR )
-        {
-            _failed( key_begin + 1, _end, "parse object [key end]", _ud );
+    js_element_string_t * key = _document->string_create( allocator, key_string );
 
-            return JS_FAILURE;
-        }
+    JS_ALLOCATOR_MEMORY_CHECK( key, JS_FAILURE );
 
-        js_size_t key_size = key_end - key_begin;
+    const char * value_begin = js_strchr( key_end + 1, _end, ':' );
 
-        js_string_t key_string = {key_begin + 1, key_size - 1};
+    if( value_begin == JS_NULLPTR )
+    {
+        _failed( key_end + 1, _end, "parse object [value separator]", _ud );
 
-        js_element_string_t * key = _document->string_create( allocator, key_string );
+        return JS_FAILURE;
+    }
 
-        JS_ALLOCATOR_MEMORY_CHECK( key, JS_FAILURE );
+    *_key = key;
 
-        const char * value_begin = js_strchr( key_end + 1, _end, ':' );
+    *_data = value_begin + 1;
 
-        if( value_begin == JS_NULLPTR )
-        {
-            _failed( key_end + 1, _end, "parse object [value separator]", _ud );
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_parse_object( js_document_t * _document, const char ** _data, const char * _end, js_failed_fun_t _failed, void * _ud, js_element_t * _object )
+{
+    const char * data_begin = *_data;
+    const char * data_iterator = data_begin + 1;
+
+    const char * value_empty = js_strskip( data_iterator, _end, " \t\n\r" );
+
+    if( value_empty != JS_NULLPTR && *value_empty == '}' )
+    {
+        *_data = value_empty + 1;
+
+        return JS_SUCCESSFUL;
+    }
+
+    data_iterator = value_empty;
 
+    for( ;; )
+    {
+        js_element_string_t * key;
+        if( __js_parse_key( _document, &data_iterator, _end, _failed, _ud, &key ) == JS_FAILURE )
+        {
             return JS_FAILURE;
         }
 
-        const char * value_iterator = value_begin + 1;
+        const char * value_iterator = data_iterator;
 
         js_element_t * value;
-        if( __js_parse_element( _document, &value_iterator, _end, '}', _failed, _ud, &value ) == JS_FAILURE )
+        if( __js_parse_element( _document, &value_iterator, _end, '}', JS_FALSE, _failed, _ud, &value ) == JS_FAILURE )
         {
             return JS_FAILURE;
         }
@@ -1041,6 +1571,23 @@ void js_make_allocator_default( js_alloc_fun_t _alloc, js_free_fun_t _free, void
     _allocator->ud = ud;
 }
 //////////////////////////////////////////////////////////////////////////
+static js_result_t __js_parse_root( js_document_t * _document, const char * _root, const char * _end, js_failed_fun_t _failed, void * _ud )
+{
+    const char * data_iterator = _root;
+
+    if( __js_parse_object( _document, &data_iterator, _end, _failed, _ud, (js_element_t *)_document ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( _document->flags & js_flag_source_span )
+    {
+        __js_element_set_source( (js_element_t *)_document, _root, data_iterator );
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
 js_result_t js_parse( js_allocator_t _allocator, js_flags_t _flags, const char * _data, js_size_t _size, js_failed_fun_t _failed, void * _ud, js_element_t ** _element )
 {
     const char * data_begin = _data;
@@ -1058,13 +1605,11 @@ js_result_t js_parse( js_allocator_t _allocator, js_flags_t _flags, const char *
         return JS_FAILURE;
     }
 
-    const char * data_iterator = data_root;
-
     js_document_t * document = __js_document_create( _allocator, _flags );
 
     JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
 
-    if( __js_parse_object( document, &data_iterator, data_end, _failed, _ud, (js_element_t *)document ) == JS_FAILURE )
+    if( __js_parse_root( document, data_root, data_end, _failed, _ud ) == JS_FAILURE )
     {
         return JS_FAILURE;
     }
@@ -1142,7 +1687,7 @@ static js_result_t __js_clone_element( js_document_t * _document, const js_eleme
         }break;
     case js_type_array:
         {
-            js_element_array_t * array_clone = __js_array_create( allocator );
+            js_element_array_t * array_clone = __js_array_create( _document );
 
             JS_ALLOCATOR_MEMORY_CHECK( array_clone, JS_FAILURE );
 
@@ -1155,7 +1700,7 @@ static js_result_t __js_clone_element( js_document_t * _document, const js_eleme
         }break;
     case js_type_object:
         {
-            js_element_object_t * object_clone = __js_object_create( allocator );
+            js_element_object_t * object_clone = __js_object_create( _document );
 
             JS_ALLOCATOR_MEMORY_CHECK( object_clone, JS_FAILURE );
 
@@ -1229,578 +1774,2753 @@ static js_result_t __js_clone_object( js_document_t * _document, js_element_t *
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_clone( js_allocator_t _allocator, js_flags_t _flags, const js_element_t * _base, js_element_t ** _total )
+static js_result_t __js_share_element( js_document_t * _document, js_element_t * _element, js_element_t ** _share )
 {
-    js_document_t * document = __js_document_create( _allocator, _flags );
-
-    JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
+    js_element_meta_t * meta = __js_element_meta( _element );
 
-    if( __js_clone_object( document, (js_element_t *)document, _base ) == JS_FAILURE )
+    if( meta == JS_NULLPTR )
     {
-        return JS_FAILURE;
+        js_result_t result = __js_clone_element( _document, _element, _share );
+
+        return result;
     }
 
-    *_total = (js_element_t *)document;
+    ++meta->refcount;
+
+    *_share = _element;
 
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-static js_result_t __js_patch_object( js_document_t * _document, js_element_t * _object, const js_element_t * _patch )
+static js_result_t __js_share_array( js_document_t * _document, js_element_t * _copy, const js_element_t * _base )
 {
-    js_element_object_t * object = JS_CAST( js_element_object_t, _object );
-    const js_element_object_t * patch = JS_CONST_CAST( js_element_object_t, _patch );
+    const js_element_array_t * base = JS_CONST_CAST( js_element_array_t, _base );
 
-    js_node_t * it_object_key = object->keys;
-    js_node_t * it_object_value = object->values;
+    const js_node_t * it_value = base->values;
 
-    for( ; it_object_key != JS_NULLPTR; it_object_key = it_object_key->next, it_object_value = it_object_value->next )
+    for( ; it_value != JS_NULLPTR; it_value = it_value->next )
     {
-        const js_element_string_t * object_key = JS_CONST_CAST( js_element_string_t, it_object_key->element );
-        js_element_t * object_value = it_object_value->element;
-
-        const js_node_t * it_patch_key = patch->keys;
-        const js_node_t * it_patch_value = patch->values;
+        js_element_t * value = it_value->element;
+        js_element_t * value_parent = __js_element_parent( value );
 
-        for( ; it_patch_key != JS_NULLPTR; it_patch_key = it_patch_key->next, it_patch_value = it_patch_value->next )
+        js_element_t * value_share;
+        if( __js_share_element( _document, value, &value_share ) == JS_FAILURE )
         {
-            const js_element_string_t * patch_key = JS_CONST_CAST( js_element_string_t, it_patch_key->element );
-            const js_element_t * patch_value = it_patch_value->element;
-
-            if( js_strzcmp( object_key->value, patch_key->value ) == JS_FALSE )
-            {
-                continue;
-            }
-
-            js_type_t object_value_type = js_type( object_value );
-            js_type_t patch_value_type = js_type( patch_value );
+            return JS_FAILURE;
+        }
 
-            if( object_value_type == js_type_object && patch_value_type == js_type_object )
-            {
-                if( __js_patch_object( _document, object_value, patch_value ) == JS_FAILURE )
-                {
-                    return JS_FAILURE;
-                }
-            }
-            else if( patch_value_type == js_type_null )
-            {
-                js_node_t * prev_object_key = object->keys;
-                js_node_t * prev_object_value = object->values;
+        if( __js_array_add( _document, _copy, value_share ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
 
-                if( prev_object_key == it_object_key )
-                {
-                    js_node_t * next_keys = it_object_key->next;
-                    js_node_t * next_values = it_object_value->next;
+        // a still shared child keeps its parent, js_*_edit relinks it once unshared
+        __js_element_set_parent( value_share, value_parent );
+    }
 
-                    __js_node_destroy( _document, it_object_key );
-                    __js_node_destroy( _document, it_object_value );
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_share_object( js_document_t * _document, js_element_t * _copy, const js_element_t * _base )
+{
+    const js_element_object_t * base = JS_CONST_CAST( js_element_object_t, _base );
 
-                    object->keys = next_keys;
-                    object->values = next_values;
+    js_allocator_t * allocator = __js_document_allocator( _document );
 
-                    it_object_key = next_keys;
-                    it_object_value = next_values;
-                }
-                else
-                {
-                    for( ; prev_object_key->next != it_object_key; prev_object_key = prev_object_key->next, prev_object_value = prev_object_value->next );
+    const js_node_t * it_key = base->keys;
+    const js_node_t * it_value = base->values;
 
-                    js_node_t * next_keys = it_object_key->next;
-                    js_node_t * next_values = it_object_value->next;
+    for( ; it_key != JS_NULLPTR; it_key = it_key->next, it_value = it_value->next )
+    {
+        const js_element_string_t * key = JS_CONST_CAST( js_element_string_t, it_key->element );
+        js_element_t * value = it_value->element;
+        js_element_t * value_parent = __js_element_parent( value );
 
-                    __js_node_destroy( _document, it_object_key );
-                    __js_node_destroy( _document, it_object_value );
+        js_element_string_t * key_clone = _document->string_create( allocator, key->value );
 
-                    prev_object_key->next = next_keys;
-                    prev_object_value->next = next_values;
-                }
-            }
-            else
-            {
-                js_element_t * patch_value_clone;
-                if( __js_clone_element( _document, patch_value, &patch_value_clone ) == JS_FAILURE )
-                {
-                    return JS_FAILURE;
-                }
+        JS_ALLOCATOR_MEMORY_CHECK( key_clone, JS_FAILURE );
 
-                __js_element_destroy( _document, object_value );
+        js_element_t * value_share;
+        if( __js_share_element( _document, value, &value_share ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
 
-                it_object_value->element = patch_value_clone;
-            }
+        if( __js_object_add( _document, _copy, key_clone, value_share ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
         }
+
+        __js_element_set_parent( value_share, value_parent );
     }
 
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_patch( js_allocator_t _allocator, js_flags_t _flags, const js_element_t * _base, const js_element_t * _patch, js_element_t ** _total )
+static js_result_t __js_unshare_element( js_document_t * _document, js_element_t * _holder, js_node_t * _node )
 {
-    js_document_t * document = __js_document_create( _allocator, _flags );
+    js_element_t * element = _node->element;
 
-    JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
+    const js_element_meta_t * meta = __js_element_meta( element );
 
-    if( __js_clone_object( document, (js_element_t *)document, _base ) == JS_FAILURE )
+    if( meta == JS_NULLPTR )
     {
-        return JS_FAILURE;
+        return JS_SUCCESSFUL;
     }
 
-    if( __js_patch_object( document, (js_element_t *)document, _patch ) == JS_FAILURE )
+    if( meta->refcount == 1 )
     {
-        return JS_FAILURE;
-    }
+        __js_element_set_parent( element, _holder );
 
-    *_total = (js_element_t *)document;
+        return JS_SUCCESSFUL;
+    }
 
-    return JS_SUCCESSFUL;
-}
-//////////////////////////////////////////////////////////////////////////
-js_result_t js_create( js_allocator_t _allocator, js_flags_t _flags, js_element_t ** _element )
-{
-    js_document_t * document = __js_document_create( _allocator, _flags );
+    js_element_t * copy;
 
-    JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
+    if( js_type( element ) == js_type_object )
+    {
+        js_element_object_t * object_copy = __js_object_create( _document );
 
-    *_element = (js_element_t *)document;
+        JS_ALLOCATOR_MEMORY_CHECK( object_copy, JS_FAILURE );
 
-    return JS_SUCCESSFUL;
-}
-//////////////////////////////////////////////////////////////////////////
-js_result_t js_object_add_field_null( js_element_t * _documet, js_element_t * _element, js_string_t _key )
-{
-    js_document_t * document = (js_document_t *)_documet;
+        if( __js_share_object( _document, (js_element_t *)object_copy, element ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
 
-    js_allocator_t * allocator = __js_document_allocator( document );
+        copy = (js_element_t *)object_copy;
+    }
+    else
+    {
+        js_element_array_t * array_copy = __js_array_create( _document );
 
-    js_element_null_t * value = __js_null_create( allocator );
+        JS_ALLOCATOR_MEMORY_CHECK( array_copy, JS_FAILURE );
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+        if( __js_share_array( _document, (js_element_t *)array_copy, element ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
 
-    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
-    {
-        return JS_FAILURE;
+        copy = (js_element_t *)array_copy;
     }
 
-    return JS_SUCCESSFUL;
-}
-//////////////////////////////////////////////////////////////////////////
-js_result_t js_object_add_field_true( js_element_t * _documet, js_element_t * _element, js_string_t _key )
-{
-    js_document_t * document = (js_document_t *)_documet;
-
-    js_allocator_t * allocator = __js_document_allocator( document );
+    js_element_meta_t * copy_meta = __js_element_meta( copy );
 
-    js_element_true_t * value = __js_true_create( allocator );
+    copy_meta->source = meta->source;
+    copy_meta->hash = meta->hash;
+    copy_meta->hashed = meta->hashed;
+    copy_meta->parent = _holder;
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+    _node->element = copy;
 
-    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
-    {
-        return JS_FAILURE;
-    }
+    __js_element_orphan( element, _holder );
+    __js_element_destroy( _document, element );
 
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_object_add_field_false( js_element_t * _documet, js_element_t * _element, js_string_t _key )
+static js_bool_t __js_document_can_share( js_flags_t _flags, const js_allocator_t * _allocator, const js_element_t * _base )
 {
-    js_document_t * document = (js_document_t *)_documet;
-
-    js_allocator_t * allocator = __js_document_allocator( document );
+    if( (_flags & js_flag_shared) == 0 || (_flags & js_flag_node_pool) != 0 )
+    {
+        return JS_FALSE;
+    }
 
-    js_element_false_t * value = __js_false_create( allocator );
+    const js_document_t * base = (const js_document_t *)_base;
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+    if( base->flags != _flags )
+    {
+        return JS_FALSE;
+    }
 
-    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
+    if( base->allocator.alloc != _allocator->alloc || base->allocator.free != _allocator->free || base->allocator.ud != _allocator->ud )
     {
-        return JS_FAILURE;
+        return JS_FALSE;
     }
 
-    return JS_SUCCESSFUL;
+    return JS_TRUE;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_object_add_field_boolean( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_bool_t _value )
+static js_result_t __js_clone_document( js_document_t * _document, const js_element_t * _base )
 {
-    if( _value == JS_TRUE )
+    if( __js_document_can_share( _document->flags, &_document->allocator, _base ) == JS_TRUE )
     {
-        js_result_t result = js_object_add_field_true( _documet, _element, _key );
+        js_result_t result = __js_share_object( _document, (js_element_t *)_document, _base );
 
         return result;
     }
-    else
-    {
-        js_result_t result = js_object_add_field_false( _documet, _element, _key );
 
-        return result;
-    }
+    js_result_t result = __js_clone_object( _document, (js_element_t *)_document, _base );
+
+    return result;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_object_add_field_integer( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_integer_t _value )
+typedef struct js_compact_t
 {
-    js_document_t * document = (js_document_t *)_documet;
-
-    js_allocator_t * allocator = __js_document_allocator( document );
+    js_allocator_t origin;
+    js_buffer_t buffer;
+} js_compact_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __js_compact_alloc( js_size_t _size, void * _ud )
+{
+    js_compact_t * compact = (js_compact_t *)_ud;
 
-    js_element_integer_t * value = __js_integer_create( allocator, _value );
+    js_size_t size = __js_memory_align( _size );
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+    js_buffer_t * buffer = &compact->buffer;
 
-    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
+    if( buffer->memory + size > buffer->end )
     {
-        return JS_FAILURE;
+        void * alloc_memory = compact->origin.alloc( _size, compact->origin.ud );
+
+        return alloc_memory;
     }
 
-    return JS_SUCCESSFUL;
+    void * alloc_memory = buffer->memory;
+
+    buffer->memory += size;
+
+    return alloc_memory;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_object_add_field_real( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_real_t _value )
+static void __js_compact_free( void * _ptr, void * _ud )
 {
-    js_document_t * document = (js_document_t *)_documet;
+    js_compact_t * compact = (js_compact_t *)_ud;
+
+    const uint8_t * ptr = (const uint8_t *)_ptr;
+
+    if( ptr >= compact->buffer.begin && ptr < compact->buffer.end )
+    {
+        return;
+    }
+
+    compact->origin.free( _ptr, compact->origin.ud );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_compact_measure_string( js_flags_t _flags, const js_element_t * _element )
+{
+    const js_element_string_t * string = JS_CONST_CAST( js_element_string_t, _element );
+
+    if( _flags & js_flag_string_inplace )
+    {
+        return __js_memory_align( sizeof( js_element_string_t ) );
+    }
+
+    js_size_t size = __js_memory_align( sizeof( js_element_string_buffer_t ) + string->value.size );
+
+    return size;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_compact_measure_element( js_flags_t _flags, const js_element_t * _element );
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_compact_measure_fields( js_flags_t _flags, const js_element_object_t * _object )
+{
+    js_size_t size = 0;
+
+    const js_node_t * it_key = _object->keys;
+    const js_node_t * it_value = _object->values;
+
+    for( ; it_key != JS_NULLPTR; it_key = it_key->next, it_value = it_value->next )
+    {
+        size += __js_memory_align( sizeof( js_node_t ) ) * 2;
+        size += __js_compact_measure_string( _flags, it_key->element );
+        size += __js_compact_measure_element( _flags, it_value->element );
+    }
+
+    return size;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_compact_measure_element( js_flags_t _flags, const js_element_t * _element )
+{
+    js_type_t type = js_type( _element );
+
+    switch( type )
+    {
+    case js_type_null:
+    case js_type_false:
+    case js_type_true:
+        {
+            // cache
+        }break;
+    case js_type_integer:
+        {
+            const js_element_integer_t * integer = JS_CONST_CAST( js_element_integer_t, _element );
+
+            if( integer->value > -256 && integer->value < 256 )
+            {
+                return 0;
+            }
+
+            return __js_memory_align( sizeof( js_element_integer_t ) );
+        }break;
+    case js_type_real:
+        {
+            const js_element_real_t * real = JS_CONST_CAST( js_element_real_t, _element );
+
+            if( real->value == 0.0 || real->value == 0.5 || real->value == 1.0 )
+            {
+                return 0;
+            }
+
+            return __js_memory_align( sizeof( js_element_real_t ) );
+        }break;
+    case js_type_string:
+        {
+            return __js_compact_measure_string( _flags, _element );
+        }break;
+    case js_type_array:
+        {
+            const js_element_array_t * array = JS_CONST_CAST( js_element_array_t, _element );
+
+            js_size_t size = __js_memory_align( (_flags & JS_META_FLAGS) != 0 ? sizeof( js_element_array_ex_t ) : sizeof( js_element_array_t ) );
+
+            for( const js_node_t * it_value = array->values; it_value != JS_NULLPTR; it_value = it_value->next )
+            {
+                size += __js_memory_align( sizeof( js_node_t ) );
+                size += __js_compact_measure_element( _flags, it_value->element );
+            }
+
+            return size;
+        }break;
+    case js_type_object:
+        {
+            const js_element_object_t * object = JS_CONST_CAST( js_element_object_t, _element );
+
+            js_size_t size = __js_memory_align( (_flags & JS_META_FLAGS) != 0 ? sizeof( js_element_object_ex_t ) : sizeof( js_element_object_t ) );
+
+            size += __js_compact_measure_fields( _flags, object );
+
+            return size;
+        }break;
+    }
+
+    return 0;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_clone_compact( js_allocator_t _allocator, js_flags_t _flags, const js_element_t * _base, js_element_t ** _total )
+{
+    js_flags_t flags = _flags & ~(js_flags_t)(js_flag_node_pool | js_flag_arena);
+
+    const js_element_object_t * base = JS_CONST_CAST( js_element_object_t, _base );
+
+    js_size_t header_size = __js_memory_align( sizeof( js_compact_t ) );
+
+    js_size_t block_size = __js_memory_align( sizeof( js_document_t ) );
+    block_size += __js_compact_measure_fields( flags, base );
+
+    uint8_t * memory = (uint8_t *)_allocator.alloc( header_size + block_size, _allocator.ud );
+
+    JS_ALLOCATOR_MEMORY_CHECK( memory, JS_FAILURE );
+
+    js_compact_t * compact = (js_compact_t *)memory;
+
+    compact->origin = _allocator;
+
+    js_make_buffer( memory + header_size, block_size, &compact->buffer );
+
+    js_allocator_t allocator;
+    allocator.alloc = &__js_compact_alloc;
+    allocator.free = &__js_compact_free;
+    allocator.ud = compact;
+
+    js_document_t * document = __js_document_create( allocator, flags );
+
+    JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
+
+    if( __js_clone_object( document, (js_element_t *)document, _base ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    *_total = (js_element_t *)document;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_clone( js_allocator_t _allocator, js_flags_t _flags, const js_element_t * _base, js_element_t ** _total )
+{
+    if( _flags & js_flag_compact )
+    {
+        js_result_t result = __js_clone_compact( _allocator, _flags, _base, _total );
+
+        return result;
+    }
+
+    js_document_t * document = __js_document_create( _allocator, _flags );
+
+    JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
+
+    if( __js_clone_document( document, _base ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    *_total = (js_element_t *)document;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_patch_slot_t
+{
+    const js_element_string_t * key;
+    const js_element_t * value;
+    uint32_t hash;
+    js_bool_t matched;
+} js_patch_slot_t;
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_patch_table_t
+{
+    js_patch_slot_t * slots;
+    js_size_t mask;
+} js_patch_table_t;
+//////////////////////////////////////////////////////////////////////////
+static js_patch_slot_t * __js_patch_table_find( const js_patch_table_t * _table, js_string_t _key, uint32_t _hash )
+{
+    for( js_size_t probe = 0;; ++probe )
+    {
+        js_patch_slot_t * slot = _table->slots + ((_hash + probe) & _table->mask);
+
+        if( slot->key == JS_NULLPTR )
+        {
+            return slot;
+        }
+
+        if( slot->hash == _hash && js_strzcmp( slot->key->value, _key ) == JS_TRUE )
+        {
+            return slot;
+        }
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_patch_table_create( js_allocator_t * _allocator, const js_element_object_t * _patch, js_patch_slot_t * _stack, js_patch_table_t * _table )
+{
+    js_size_t capacity = 4;
+    while( capacity < _patch->size * 2 )
+    {
+        capacity <<= 1;
+    }
+
+    _table->mask = capacity - 1;
+
+    if( capacity <= JS_PATCH_HASH_STACK_SIZE )
+    {
+        _table->slots = _stack;
+    }
+    else
+    {
+        _table->slots = (js_patch_slot_t *)_allocator->alloc( sizeof( js_patch_slot_t ) * capacity, _allocator->ud );
+
+        JS_ALLOCATOR_MEMORY_CHECK( _table->slots, JS_FAILURE );
+    }
+
+    for( js_size_t index = 0; index != capacity; ++index )
+    {
+        _table->slots[index].key = JS_NULLPTR;
+    }
+
+    const js_node_t * it_key = _patch->keys;
+    const js_node_t * it_value = _patch->values;
+
+    for( ; it_key != JS_NULLPTR; it_key = it_key->next, it_value = it_value->next )
+    {
+        const js_element_string_t * key = JS_CONST_CAST( js_element_string_t, it_key->element );
+
+        uint32_t hash = js_strhash( key->value );
+
+        js_patch_slot_t * slot = __js_patch_table_find( _table, key->value, hash );
+
+        if( slot->key != JS_NULLPTR )
+        {
+            continue;
+        }
+
+        slot->key = key;
+        slot->value = it_value->element;
+        slot->hash = hash;
+        slot->matched = JS_FALSE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_patch_table_destroy( js_allocator_t * _allocator, js_patch_table_t * _table, js_patch_slot_t * _stack )
+{
+    if( _table->slots == _stack )
+    {
+        return;
+    }
+
+    _allocator->free( _table->slots, _allocator->ud );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_patch_object( js_document_t * _document, js_element_t * _object, const js_element_t * _patch );
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_patch_value( js_document_t * _document, const js_element_t * _patch, js_element_t ** _value )
+{
+    if( js_type( _patch ) != js_type_object )
+    {
+        if( __js_clone_element( _document, _patch, _value ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        return JS_SUCCESSFUL;
+    }
+
+    js_element_object_t * object = __js_object_create( _document );
+
+    JS_ALLOCATOR_MEMORY_CHECK( object, JS_FAILURE );
+
+    if( __js_patch_object( _document, (js_element_t *)object, _patch ) == JS_FAILURE )
+    {
+        __js_element_destroy( _document, (js_element_t *)object );
+
+        return JS_FAILURE;
+    }
+
+    *_value = (js_element_t *)object;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_patch_object_join( js_document_t * _document, js_element_t * _object, const js_patch_table_t * _table, const js_element_object_t * _patch )
+{
+    js_allocator_t * allocator = __js_document_allocator( _document );
+
+    js_element_object_t * object = JS_CAST( js_element_object_t, _object );
+
+    js_node_t * prev_object_key = JS_NULLPTR;
+    js_node_t * prev_object_value = JS_NULLPTR;
+
+    js_node_t * it_object_key = object->keys;
+    js_node_t * it_object_value = object->values;
+
+    while( it_object_key != JS_NULLPTR )
+    {
+        js_node_t * next_object_key = it_object_key->next;
+        js_node_t * next_object_value = it_object_value->next;
+
+        const js_element_string_t * object_key = JS_CONST_CAST( js_element_string_t, it_object_key->element );
+        js_element_t * object_value = it_object_value->element;
+
+        js_patch_slot_t * slot = __js_patch_table_find( _table, object_key->value, js_strhash( object_key->value ) );
+
+        if( slot->key == JS_NULLPTR )
+        {
+            prev_object_key = it_object_key;
+            prev_object_value = it_object_value;
+
+            it_object_key = next_object_key;
+            it_object_value = next_object_value;
+
+            continue;
+        }
+
+        slot->matched = JS_TRUE;
+
+        const js_element_t * patch_value = slot->value;
+
+        if( js_type( patch_value ) == js_type_null )
+        {
+
+            if( prev_object_key == JS_NULLPTR )
+            {
+                object->keys = next_object_key;
+                object->values = next_object_value;
+            }
+            else
+            {
+                prev_object_key->next = next_object_key;
+                prev_object_value->next = next_object_value;
+            }
+
+            if( next_object_key == JS_NULLPTR )
+            {
+                object->keys_last = prev_object_key;
+                object->values_last = prev_object_value;
+            }
+
+            __js_node_destroy( _document, it_object_key );
+            __js_node_release( _document, _object, it_object_value );
+
+            --object->size;
+        }
+        else if( js_type( object_value ) == js_type_object && js_type( patch_value ) == js_type_object )
+        {
+            if( __js_unshare_element( _document, _object, it_object_value ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            object_value = it_object_value->element;
+
+            if( __js_patch_object( _document, object_value, patch_value ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            prev_object_key = it_object_key;
+            prev_object_value = it_object_value;
+        }
+        else
+        {
+            js_element_t * value;
+            if( __js_patch_value( _document, patch_value, &value ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            __js_element_orphan( object_value, _object );
+            __js_element_destroy( _document, object_value );
+
+            __js_element_set_parent( value, _object );
+
+            it_object_value->element = value;
+
+            prev_object_key = it_object_key;
+            prev_object_value = it_object_value;
+        }
+
+        it_object_key = next_object_key;
+        it_object_value = next_object_value;
+    }
+
+    const js_node_t * it_patch_key = _patch->keys;
+
+    for( ; it_patch_key != JS_NULLPTR; it_patch_key = it_patch_key->next )
+    {
+        const js_element_string_t * patch_key = JS_CONST_CAST( js_element_string_t, it_patch_key->element );
+
+        js_patch_slot_t * slot = __js_patch_table_find( _table, patch_key->value, js_strhash( patch_key->value ) );
+
+        if( slot->matched == JS_TRUE )
+        {
+            continue;
+        }
+
+        slot->matched = JS_TRUE;
+
+        const js_element_t * patch_value = slot->value;
+
+        if( js_type( patch_value ) == js_type_null )
+        {
+            continue;
+        }
+
+        js_element_string_t * key = _document->string_create( allocator, patch_key->value );
+
+        JS_ALLOCATOR_MEMORY_CHECK( key, JS_FAILURE );
+
+        js_element_t * value;
+        if( __js_patch_value( _document, patch_value, &value ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        if( __js_object_add( _document, _object, key, value ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_patch_object( js_document_t * _document, js_element_t * _object, const js_element_t * _patch )
+{
+    js_allocator_t * allocator = __js_document_allocator( _document );
+
+    const js_element_object_t * patch = JS_CONST_CAST( js_element_object_t, _patch );
+
+    if( patch->size == 0 )
+    {
+        return JS_SUCCESSFUL;
+    }
+
+    __js_element_touch( _object );
+
+    js_patch_slot_t slots_stack[JS_PATCH_HASH_STACK_SIZE];
+
+    js_patch_table_t table;
+    if( __js_patch_table_create( allocator, patch, slots_stack, &table ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    js_result_t result = __js_patch_object_join( _document, _object, &table, patch );
+
+    __js_patch_table_destroy( allocator, &table, slots_stack );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_patch( js_allocator_t _allocator, js_flags_t _flags, const js_element_t * _base, const js_element_t * _patch, js_element_t ** _total )
+{
+    js_document_t * document = __js_document_create( _allocator, _flags );
+
+    JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
+
+    if( __js_clone_document( document, _base ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( __js_patch_object( document, (js_element_t *)document, _patch ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    *_total = (js_element_t *)document;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_patch_inplace( js_element_t * _document, const js_element_t * _patch )
+{
+    js_document_t * document = (js_document_t *)_document;
+
+    if( __js_patch_object( document, _document, _patch ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_hash_t __js_hash_mix( js_hash_t _hash, uint64_t _value )
+{
+    uint64_t x = _value ^ ((uint64_t)_hash * 0x9e3779b97f4a7c15ULL);
+
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+
+    js_hash_t hash = (js_hash_t)(x ^ (x >> 32));
+
+    return hash;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_hash_t __js_hash_array( const js_element_array_t * _array )
+{
+    js_hash_t hash = __js_hash_mix( js_type_array, _array->size );
+
+    const js_node_t * it_value = _array->values;
+
+    for( ; it_value != JS_NULLPTR; it_value = it_value->next )
+    {
+        hash = __js_hash_mix( hash, js_hash( it_value->element ) );
+    }
+
+    return hash;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_hash_t __js_hash_object( const js_element_object_t * _object )
+{
+    js_hash_t fields = 0;
+
+    const js_node_t * it_key = _object->keys;
+    const js_node_t * it_value = _object->values;
+
+    for( ; it_key != JS_NULLPTR; it_key = it_key->next, it_value = it_value->next )
+    {
+        const js_element_string_t * key = JS_CONST_CAST( js_element_string_t, it_key->element );
+
+        fields += __js_hash_mix( js_strhash( key->value ), js_hash( it_value->element ) );
+    }
+
+    js_hash_t hash = __js_hash_mix( __js_hash_mix( js_type_object, _object->size ), fields );
+
+    return hash;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_hash_t __js_hash_container( const js_element_t * _element )
+{
+    if( js_type( _element ) == js_type_array )
+    {
+        const js_element_array_t * array = JS_CONST_CAST( js_element_array_t, _element );
+
+        js_hash_t hash = __js_hash_array( array );
+
+        return hash;
+    }
+
+    const js_element_object_t * object = JS_CONST_CAST( js_element_object_t, _element );
+
+    js_hash_t hash = __js_hash_object( object );
+
+    return hash;
+}
+//////////////////////////////////////////////////////////////////////////
+js_hash_t js_hash( const js_element_t * _element )
+{
+    js_type_t type = js_type( _element );
+
+    switch( type )
+    {
+    case js_type_null:
+    case js_type_false:
+    case js_type_true:
+        return __js_hash_mix( type, 0 );
+    case js_type_integer:
+        {
+            js_integer_t value = js_get_integer( _element );
+
+            return __js_hash_mix( type, (uint64_t)value );
+        }
+    case js_type_real:
+        {
+            union
+            {
+                js_real_t real;
+                uint64_t bits;
+            } value;
+
+            value.real = js_get_real( _element );
+
+            if( value.real == 0.0 )
+            {
+                value.bits = 0;
+            }
+
+            return __js_hash_mix( type, value.bits );
+        }
+    case js_type_string:
+        {
+            const js_element_string_t * string = JS_CONST_CAST( js_element_string_t, _element );
+
+            return __js_hash_mix( type, js_strhash( string->value ) );
+        }
+    case js_type_array:
+    case js_type_object:
+        {
+            js_element_meta_t * meta = __js_element_meta( _element );
+
+            if( meta == JS_NULLPTR )
+            {
+                js_hash_t hash = __js_hash_container( _element );
+
+                return hash;
+            }
+
+            if( meta->hashed == JS_FALSE )
+            {
+                meta->hash = __js_hash_container( _element );
+                meta->hashed = JS_TRUE;
+            }
+
+            return meta->hash;
+        }
+    }
+
+    return 0;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_equal_element( js_allocator_t * _allocator, const js_element_t * _a, const js_element_t * _b );
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_equal_array( js_allocator_t * _allocator, const js_element_t * _a, const js_element_t * _b )
+{
+    const js_element_array_t * a = JS_CONST_CAST( js_element_array_t, _a );
+    const js_element_array_t * b = JS_CONST_CAST( js_element_array_t, _b );
+
+    if( a->size != b->size )
+    {
+        return JS_FALSE;
+    }
+
+    const js_node_t * it_a = a->values;
+    const js_node_t * it_b = b->values;
+
+    for( ; it_a != JS_NULLPTR; it_a = it_a->next, it_b = it_b->next )
+    {
+        if( __js_equal_element( _allocator, it_a->element, it_b->element ) == JS_FALSE )
+        {
+            return JS_FALSE;
+        }
+    }
+
+    return JS_TRUE;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_equal_object_scan( js_allocator_t * _allocator, const js_element_t * _b, const js_node_t * _a_key, const js_node_t * _a_value )
+{
+    const js_node_t * it_a_key = _a_key;
+    const js_node_t * it_a_value = _a_value;
+
+    for( ; it_a_key != JS_NULLPTR; it_a_key = it_a_key->next, it_a_value = it_a_value->next )
+    {
+        const js_element_string_t * a_key = JS_CONST_CAST( js_element_string_t, it_a_key->element );
+
+        const js_element_t * b_value = js_object_getn( _b, a_key->value );
+
+        if( b_value == JS_NULLPTR )
+        {
+            return JS_FALSE;
+        }
+
+        if( __js_equal_element( _allocator, it_a_value->element, b_value ) == JS_FALSE )
+        {
+            return JS_FALSE;
+        }
+    }
+
+    return JS_TRUE;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_equal_object_join( js_allocator_t * _allocator, const js_element_t * _b, const js_node_t * _a_key, const js_node_t * _a_value )
+{
+    const js_element_object_t * b = JS_CONST_CAST( js_element_object_t, _b );
+
+    js_patch_slot_t slots_stack[JS_PATCH_HASH_STACK_SIZE];
+
+    js_patch_table_t table;
+    if( __js_patch_table_create( _allocator, b, slots_stack, &table ) == JS_FAILURE )
+    {
+        js_bool_t result = __js_equal_object_scan( _allocator, _b, _a_key, _a_value );
+
+        return result;
+    }
+
+    js_bool_t result = JS_TRUE;
+
+    const js_node_t * it_a_key = _a_key;
+    const js_node_t * it_a_value = _a_value;
+
+    for( ; it_a_key != JS_NULLPTR; it_a_key = it_a_key->next, it_a_value = it_a_value->next )
+    {
+        const js_element_string_t * a_key = JS_CONST_CAST( js_element_string_t, it_a_key->element );
+
+        const js_patch_slot_t * slot = __js_patch_table_find( &table, a_key->value, js_strhash( a_key->value ) );
+
+        if( slot->key == JS_NULLPTR || __js_equal_element( _allocator, it_a_value->element, slot->value ) == JS_FALSE )
+        {
+            result = JS_FALSE;
+
+            break;
+        }
+    }
+
+    __js_patch_table_destroy( _allocator, &table, slots_stack );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_equal_object( js_allocator_t * _allocator, const js_element_t * _a, const js_element_t * _b )
+{
+    const js_element_object_t * a = JS_CONST_CAST( js_element_object_t, _a );
+    const js_element_object_t * b = JS_CONST_CAST( js_element_object_t, _b );
+
+    if( a->size != b->size )
+    {
+        return JS_FALSE;
+    }
+
+    const js_node_t * it_a_key = a->keys;
+    const js_node_t * it_a_value = a->values;
+    const js_node_t * it_b_key = b->keys;
+    const js_node_t * it_b_value = b->values;
+
+    for( ; it_a_key != JS_NULLPTR; it_a_key = it_a_key->next, it_a_value = it_a_value->next, it_b_key = it_b_key->next, it_b_value = it_b_value->next )
+    {
+        const js_element_string_t * a_key = JS_CONST_CAST( js_element_string_t, it_a_key->element );
+        const js_element_string_t * b_key = JS_CONST_CAST( js_element_string_t, it_b_key->element );
+
+        if( js_strzcmp( a_key->value, b_key->value ) == JS_FALSE )
+        {
+            js_bool_t result = __js_equal_object_join( _allocator, _b, it_a_key, it_a_value );
+
+            return result;
+        }
+
+        if( __js_equal_element( _allocator, it_a_value->element, it_b_value->element ) == JS_FALSE )
+        {
+            return JS_FALSE;
+        }
+    }
+
+    return JS_TRUE;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_equal_element( js_allocator_t * _allocator, const js_element_t * _a, const js_element_t * _b )
+{
+    if( _a == _b )
+    {
+        return JS_TRUE;
+    }
+
+    js_type_t type = js_type( _a );
+
+    if( type != js_type( _b ) )
+    {
+        return JS_FALSE;
+    }
+
+    switch( type )
+    {
+    case js_type_null:
+    case js_type_false:
+    case js_type_true:
+        return JS_TRUE;
+    case js_type_integer:
+        return js_get_integer( _a ) == js_get_integer( _b );
+    case js_type_real:
+        return js_get_real( _a ) == js_get_real( _b );
+    case js_type_string:
+        {
+            const js_element_string_t * a = JS_CONST_CAST( js_element_string_t, _a );
+            const js_element_string_t * b = JS_CONST_CAST( js_element_string_t, _b );
+
+            return js_strzcmp( a->value, b->value );
+        }
+    case js_type_array:
+    case js_type_object:
+        {
+            if( __js_element_meta( _a ) != JS_NULLPTR && __js_element_meta( _b ) != JS_NULLPTR && js_hash( _a ) != js_hash( _b ) )
+            {
+                return JS_FALSE;
+            }
+
+            if( type == js_type_array )
+            {
+                return __js_equal_array( _allocator, _a, _b );
+            }
+
+            return __js_equal_object( _allocator, _a, _b );
+        }
+    }
+
+    return JS_FALSE;
+}
+//////////////////////////////////////////////////////////////////////////
+js_bool_t js_equal( js_allocator_t _allocator, const js_element_t * _a, const js_element_t * _b )
+{
+    js_bool_t result = __js_equal_element( &_allocator, _a, _b );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_diff_add( js_document_t * _document, js_element_t * _patch, const js_element_string_t * _key, js_element_t * _value )
+{
+    js_allocator_t * allocator = __js_document_allocator( _document );
+
+    js_element_string_t * key = _document->string_create( allocator, _key->value );
+
+    JS_ALLOCATOR_MEMORY_CHECK( key, JS_FAILURE );
+
+    if( __js_object_add( _document, _patch, key, _value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_diff_object_join( js_document_t * _document, js_element_t * _patch, const js_element_object_t * _base, const js_element_object_t * _total, const js_patch_table_t * _table );
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_diff_object( js_document_t * _document, js_element_t * _patch, const js_element_t * _base, const js_element_t * _total )
+{
+    js_allocator_t * allocator = __js_document_allocator( _document );
+
+    const js_element_object_t * base = JS_CONST_CAST( js_element_object_t, _base );
+    const js_element_object_t * total = JS_CONST_CAST( js_element_object_t, _total );
+
+    js_patch_slot_t slots_stack[JS_PATCH_HASH_STACK_SIZE];
+
+    js_patch_table_t table;
+    if( __js_patch_table_create( allocator, total, slots_stack, &table ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    js_result_t result = __js_diff_object_join( _document, _patch, base, total, &table );
+
+    __js_patch_table_destroy( allocator, &table, slots_stack );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_diff_object_join( js_document_t * _document, js_element_t * _patch, const js_element_object_t * _base, const js_element_object_t * _total, const js_patch_table_t * _table )
+{
+    js_allocator_t * allocator = __js_document_allocator( _document );
+
+    const js_node_t * it_base_key = _base->keys;
+    const js_node_t * it_base_value = _base->values;
+
+    for( ; it_base_key != JS_NULLPTR; it_base_key = it_base_key->next, it_base_value = it_base_value->next )
+    {
+        const js_element_string_t * base_key = JS_CONST_CAST( js_element_string_t, it_base_key->element );
+        const js_element_t * base_value = it_base_value->element;
+
+        js_patch_slot_t * slot = __js_patch_table_find( _table, base_key->value, js_strhash( base_key->value ) );
+
+        if( slot->key == JS_NULLPTR )
+        {
+            js_element_null_t * null = __js_null_create( allocator );
+
+            JS_ALLOCATOR_MEMORY_CHECK( null, JS_FAILURE );
+
+            if( __js_diff_add( _document, _patch, base_key, (js_element_t *)null ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            continue;
+        }
+
+        slot->matched = JS_TRUE;
+
+        const js_element_t * total_value = slot->value;
+
+        if( __js_equal_element( allocator, base_value, total_value ) == JS_TRUE )
+        {
+            continue;
+        }
+
+        if( js_type( base_value ) == js_type_object && js_type( total_value ) == js_type_object )
+        {
+            js_element_object_t * object = __js_object_create( _document );
+
+            JS_ALLOCATOR_MEMORY_CHECK( object, JS_FAILURE );
+
+            if( __js_diff_add( _document, _patch, base_key, (js_element_t *)object ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            if( __js_diff_object( _document, (js_element_t *)object, base_value, total_value ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            continue;
+        }
+
+        js_element_t * value;
+        if( __js_clone_element( _document, total_value, &value ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        if( __js_diff_add( _document, _patch, base_key, value ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+    }
+
+    const js_node_t * it_total_key = _total->keys;
+
+    for( ; it_total_key != JS_NULLPTR; it_total_key = it_total_key->next )
+    {
+        const js_element_string_t * total_key = JS_CONST_CAST( js_element_string_t, it_total_key->element );
+
+        js_patch_slot_t * slot = __js_patch_table_find( _table, total_key->value, js_strhash( total_key->value ) );
+
+        if( slot->matched == JS_TRUE )
+        {
+            continue;
+        }
+
+        slot->matched = JS_TRUE;
+
+        js_element_t * value;
+        if( __js_clone_element( _document, slot->value, &value ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        if( __js_diff_add( _document, _patch, slot->key, value ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_diff( js_allocator_t _allocator, js_flags_t _flags, const js_element_t * _base, const js_element_t * _total, js_element_t ** _patch )
+{
+    js_document_t * document = __js_document_create( _allocator, _flags );
+
+    JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
+
+    if( __js_diff_object( document, (js_element_t *)document, _base, _total ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    *_patch = (js_element_t *)document;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_create( js_allocator_t _allocator, js_flags_t _flags, js_element_t ** _element )
+{
+    js_document_t * document = __js_document_create( _allocator, _flags );
+
+    JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
+
+    *_element = (js_element_t *)document;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_add_field_null( js_element_t * _documet, js_element_t * _element, js_string_t _key )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_null_t * value = __js_null_create( allocator );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_add_field_true( js_element_t * _documet, js_element_t * _element, js_string_t _key )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_true_t * value = __js_true_create( allocator );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_add_field_false( js_element_t * _documet, js_element_t * _element, js_string_t _key )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_false_t * value = __js_false_create( allocator );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_add_field_boolean( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_bool_t _value )
+{
+    if( _value == JS_TRUE )
+    {
+        js_result_t result = js_object_add_field_true( _documet, _element, _key );
+
+        return result;
+    }
+    else
+    {
+        js_result_t result = js_object_add_field_false( _documet, _element, _key );
+
+        return result;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_add_field_integer( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_integer_t _value )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_integer_t * value = __js_integer_create( allocator, _value );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_add_field_real( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_real_t _value )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_real_t * value = __js_real_create( allocator, _value );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_add_field_string( js_element_t * _documet, js_element_t * _element, js_string_t _key, const char * _value )
+{
+    js_size_t value_size = js_strlen( _value );
+
+    js_string_t value_string = {_value, value_size};
+
+    js_result_t result = js_object_add_field_stringn( _documet, _element, _key, value_string );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_add_field_stringn( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_string_t _value )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_string_t * value = document->string_create( allocator, _value );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_add_field_array( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_element_t ** _array )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_element_array_t * array = __js_array_create( document );
+
+    JS_ALLOCATOR_MEMORY_CHECK( array, JS_FAILURE );
+
+    if( __js_object_add_string( document, _element, _key, (js_element_t *)array ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    *_array = (js_element_t *)array;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_add_field_object( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_element_t ** _object )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_element_object_t * object = __js_object_create( document );
+
+    JS_ALLOCATOR_MEMORY_CHECK( object, JS_FAILURE );
+
+    if( __js_object_add_string( document, _element, _key, (js_element_t *)object ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    *_object = (js_element_t *)object;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_push_null( js_element_t * _documet, js_element_t * _element )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_null_t * value = __js_null_create( allocator );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_array_push( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_push_true( js_element_t * _documet, js_element_t * _element )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_true_t * value = __js_true_create( allocator );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_array_push( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_push_false( js_element_t * _documet, js_element_t * _element )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_false_t * value = __js_false_create( allocator );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_array_push( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_push_boolean( js_element_t * _documet, js_element_t * _element, js_bool_t _value )
+{
+    if( _value == JS_TRUE )
+    {
+        js_result_t result = js_array_push_true( _documet, _element );
+
+        return result;
+    }
+    else
+    {
+        js_result_t result = js_array_push_false( _documet, _element );
+
+        return result;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_push_integer( js_element_t * _documet, js_element_t * _element, js_integer_t _value )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_integer_t * value = __js_integer_create( allocator, _value );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_array_push( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_push_real( js_element_t * _documet, js_element_t * _element, js_real_t _value )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_real_t * value = __js_real_create( allocator, _value );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_array_push( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_push_string( js_element_t * _documet, js_element_t * _element, const char * _value )
+{
+    js_size_t value_size = js_strlen( _value );
+
+    js_string_t value_string = {_value, value_size};
+
+    js_result_t result = js_array_push_stringn( _documet, _element, value_string );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_push_stringn( js_element_t * _documet, js_element_t * _element, js_string_t _value )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_allocator_t * allocator = __js_document_allocator( document );
+
+    js_element_string_t * value = document->string_create( allocator, _value );
+
+    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+
+    if( __js_array_push( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_push_array( js_element_t * _documet, js_element_t * _element, js_element_t ** _array )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_element_array_t * array = __js_array_create( document );
+
+    JS_ALLOCATOR_MEMORY_CHECK( array, JS_FAILURE );
+
+    if( __js_array_push( document, _element, (js_element_t *)array ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    *_array = (js_element_t *)array;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_push_object( js_element_t * _documet, js_element_t * _element, js_element_t ** _object )
+{
+    js_document_t * document = (js_document_t *)_documet;
+
+    js_element_object_t * object = __js_object_create( document );
+
+    JS_ALLOCATOR_MEMORY_CHECK( object, JS_FAILURE );
+
+    if( __js_array_push( document, _element, (js_element_t *)object ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    *_object = (js_element_t *)object;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_array_remove( js_element_t * _document, js_element_t * _element, js_size_t _index )
+{
+    js_document_t * document = (js_document_t *)_document;
+
+    if( __js_element_writable( document, _element ) == JS_FALSE )
+    {
+        return;
+    }
+
+    __js_element_touch( _element );
+
+    js_element_array_t * array = JS_CAST( js_element_array_t, _element );
+
+    js_node_t * prev = JS_NULLPTR;
+    js_node_t * it = array->values;
+
+    for( js_size_t index = 0; index != _index; ++index )
+    {
+        JS_ASSERT( it->next != JS_NULLPTR, JS_CODE_FILE, JS_CODE_LINE );
+
+        prev = it;
+        it = it->next;
+    }
+
+    js_node_t * next = it->next;
+
+    if( prev == JS_NULLPTR )
+    {
+        array->values = next;
+    }
+    else
+    {
+        prev->next = next;
+    }
+
+    if( next == JS_NULLPTR )
+    {
+        array->values_last = prev;
+    }
+
+    __js_node_release( document, _element, it );
+
+    --array->size;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_array_clear( js_element_t * _document, js_element_t * _element )
+{
+    js_document_t * document = (js_document_t *)_document;
+
+    if( __js_element_writable( document, _element ) == JS_FALSE )
+    {
+        return;
+    }
+
+    __js_element_touch( _element );
+
+    js_element_array_t * array = JS_CAST( js_element_array_t, _element );
+
+    js_node_t * it = array->values;
+
+    for( ; it != JS_NULLPTR; )
+    {
+        js_node_t * free_node = it;
+
+        it = it->next;
+
+        __js_node_release( document, _element, free_node );
+    }
+
+    array->values = JS_NULLPTR;
+    array->values_last = JS_NULLPTR;
+    array->size = 0;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_node_forget( js_document_t * _document, js_node_t * _node )
+{
+    if( _document->flags & js_flag_node_pool )
+    {
+        return;
+    }
+
+    js_allocator_t * allocator = __js_document_allocator( _document );
+
+    allocator->free( _node, allocator->ud );
+}
+//////////////////////////////////////////////////////////////////////////
+js_element_t * js_array_detach( js_element_t * _document, js_element_t * _element, js_size_t _index )
+{
+    js_document_t * document = (js_document_t *)_document;
+
+    if( __js_element_writable( document, _element ) == JS_FALSE )
+    {
+        return JS_NULLPTR;
+    }
+
+    js_element_array_t * array = JS_CAST( js_element_array_t, _element );
+
+    if( _index >= array->size )
+    {
+        return JS_NULLPTR;
+    }
+
+    __js_element_touch( _element );
+
+    js_node_t * prev = JS_NULLPTR;
+    js_node_t * it = array->values;
+
+    for( js_size_t index = 0; index != _index; ++index )
+    {
+        prev = it;
+        it = it->next;
+    }
+
+    js_node_t * next = it->next;
+
+    if( prev == JS_NULLPTR )
+    {
+        array->values = next;
+    }
+    else
+    {
+        prev->next = next;
+    }
+
+    if( next == JS_NULLPTR )
+    {
+        array->values_last = prev;
+    }
+
+    --array->size;
+
+    js_element_t * value = it->element;
+
+    __js_element_detach( value, _element, (js_element_t *)document );
+    __js_node_forget( document, it );
+
+    return value;
+}
+//////////////////////////////////////////////////////////////////////////
+js_element_t * js_object_detach( js_element_t * _document, js_element_t * _element, const char * _key )
+{
+    js_document_t * document = (js_document_t *)_document;
+
+    if( __js_element_writable( document, _element ) == JS_FALSE )
+    {
+        return JS_NULLPTR;
+    }
+
+    js_element_object_t * object = JS_CAST( js_element_object_t, _element );
+
+    js_string_t key_string;
+    key_string.value = _key;
+    key_string.size = js_strlen( _key );
+
+    js_node_t * prev_key = JS_NULLPTR;
+    js_node_t * prev_value = JS_NULLPTR;
+
+    js_node_t * it_key = object->keys;
+    js_node_t * it_value = object->values;
+
+    for( ; it_key != JS_NULLPTR; prev_key = it_key, prev_value = it_value, it_key = it_key->next, it_value = it_value->next )
+    {
+        const js_element_string_t * key = JS_CONST_CAST( js_element_string_t, it_key->element );
+
+        if( js_strzcmp( key_string, key->value ) == JS_FALSE )
+        {
+            continue;
+        }
+
+        __js_element_touch( _element );
+
+        js_node_t * next_key = it_key->next;
+        js_node_t * next_value = it_value->next;
+
+        if( prev_key == JS_NULLPTR )
+        {
+            object->keys = next_key;
+            object->values = next_value;
+        }
+        else
+        {
+            prev_key->next = next_key;
+            prev_value->next = next_value;
+        }
+
+        if( next_key == JS_NULLPTR )
+        {
+            object->keys_last = prev_key;
+            object->values_last = prev_value;
+        }
+
+        --object->size;
+
+        js_element_t * value = it_value->element;
+
+        __js_node_destroy( document, it_key );
+
+        __js_element_detach( value, _element, (js_element_t *)document );
+        __js_node_forget( document, it_value );
+
+        return value;
+    }
+
+    return JS_NULLPTR;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_document_can_adopt( const js_document_t * _document, const js_document_t * _from )
+{
+    if( _document == _from )
+    {
+        return JS_TRUE;
+    }
+
+    if( (_document->flags & js_flag_node_pool) != 0 || (_from->flags & js_flag_node_pool) != 0 )
+    {
+        return JS_FALSE;
+    }
+
+    if( (_from->flags & js_flag_string_inplace) != 0 && (_document->flags & js_flag_string_inplace) == 0 )
+    {
+        return JS_FALSE;
+    }
+
+    if( (_from->flags & js_flag_shared) != 0 && (_document->flags & js_flag_shared) == 0 )
+    {
+        return JS_FALSE;
+    }
+
+    if( ((_from->flags & JS_META_FLAGS) != 0) != ((_document->flags & JS_META_FLAGS) != 0) )
+    {
+        return JS_FALSE;
+    }
+
+    if( _document->allocator.alloc != _from->allocator.alloc || _document->allocator.free != _from->allocator.free || _document->allocator.ud != _from->allocator.ud )
+    {
+        return JS_FALSE;
+    }
+
+    return JS_TRUE;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_adopt_element( js_document_t * _document, js_document_t * _from, js_element_t * _element, js_element_t ** _adopt )
+{
+    if( __js_document_can_adopt( _document, _from ) == JS_TRUE )
+    {
+        *_adopt = _element;
+
+        return JS_SUCCESSFUL;
+    }
+
+    js_result_t result = __js_clone_element( _document, _element, _adopt );
+
+    __js_element_destroy( _from, _element );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_array_attach( js_element_t * _document, js_element_t * _element, js_element_t * _from, js_element_t * _value )
+{
+    js_document_t * document = (js_document_t *)_document;
+    js_document_t * from = (js_document_t *)_from;
+
+    js_element_t * value;
+    if( __js_adopt_element( document, from, _value, &value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( __js_array_push( document, _element, value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_attach( js_element_t * _document, js_element_t * _element, js_string_t _key, js_element_t * _from, js_element_t * _value )
+{
+    js_document_t * document = (js_document_t *)_document;
+    js_document_t * from = (js_document_t *)_from;
+
+    js_element_t * value;
+    if( __js_adopt_element( document, from, _value, &value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( __js_object_add_string( document, _element, _key, value ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_object_move( js_element_t * _document, js_element_t * _element, js_string_t _key, js_element_t * _from, js_element_t * _from_element, const char * _from_key )
+{
+    js_document_t * document = (js_document_t *)_document;
+
+    if( __js_element_writable( document, _element ) == JS_FALSE )
+    {
+        return JS_FAILURE;
+    }
+
+    js_element_t * value = js_object_detach( _from, _from_element, _from_key );
+
+    if( value == JS_NULLPTR )
+    {
+        return JS_FAILURE;
+    }
+
+    js_result_t result = js_object_attach( _document, _element, _key, _from, value );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_discard( js_element_t * _document, js_element_t * _value )
+{
+    js_document_t * document = (js_document_t *)_document;
+
+    __js_element_destroy( document, _value );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_document_clear( js_document_t * _document )
+{
+    js_node_t * it_key = _document->object.keys;
+    js_node_t * it_value = _document->object.values;
+
+    for( ; it_key != JS_NULLPTR; )
+    {
+        js_node_t * free_key = it_key;
+        js_node_t * free_value = it_value;
+
+        it_key = it_key->next;
+        it_value = it_value->next;
+
+        __js_node_destroy( _document, free_key );
+        __js_node_release( _document, (js_element_t *)_document, free_value );
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_document_destroy( js_document_t * _document )
+{
+    js_allocator_t * allocator = __js_document_allocator( _document );
+
+    js_flags_t flags = _document->flags;
+
+    if( flags & js_flag_node_pool )
+    {
+        for( js_block_t * block = _document->free_block; block != JS_NULLPTR; )
+        {
+            js_block_t * free_block = block;
+            block = block->prev;
+
+            allocator->free( free_block, allocator->ud );
+        }
+    }
+
+    if( allocator->free == &__js_compact_free )
+    {
+        js_compact_t * compact = (js_compact_t *)allocator->ud;
+
+        js_allocator_t origin = compact->origin;
+
+        origin.free( compact, origin.ud );
+
+        return;
+    }
+
+    allocator->free( _document, allocator->ud );
+}
+//////////////////////////////////////////////////////////////////////////
+void js_free( js_element_t * _element )
+{
+    js_document_t * document = (js_document_t *)_element;
 
     js_allocator_t * allocator = __js_document_allocator( document );
 
-    js_element_real_t * value = __js_real_create( allocator, _value );
+    if( allocator->free == &__js_arena_free )
+    {
+        js_arena_t * arena = (js_arena_t *)allocator->ud;
+
+        __js_arena_destroy( arena );
+
+        return;
+    }
+
+    __js_document_clear( document );
+
+    __js_document_destroy( document );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_free_step( js_document_t * _document )
+{
+    js_node_t * frame = _document->free_top;
+
+    js_element_t * top = frame == JS_NULLPTR ? (js_element_t *)_document : frame->element;
+
+    js_node_t * node;
+
+    if( js_type( top ) == js_type_object )
+    {
+        js_element_object_t * object = JS_CAST( js_element_object_t, top );
+
+        js_node_t * key = object->keys;
+
+        if( key != JS_NULLPTR )
+        {
+            object->keys = key->next;
+
+            __js_node_destroy( _document, key );
+        }
+
+        node = object->values;
+
+        if( node != JS_NULLPTR )
+        {
+            object->values = node->next;
+        }
+    }
+    else
+    {
+        js_element_array_t * array = JS_CAST( js_element_array_t, top );
+
+        node = array->values;
+
+        if( node != JS_NULLPTR )
+        {
+            array->values = node->next;
+        }
+    }
+
+    if( node == JS_NULLPTR )
+    {
+        if( frame == JS_NULLPTR )
+        {
+            return JS_FALSE;
+        }
+
+        _document->free_top = frame->next;
+
+        __js_node_forget( _document, frame );
+
+        js_allocator_t * allocator = __js_document_allocator( _document );
+
+        allocator->free( top, allocator->ud );
+
+        return JS_TRUE;
+    }
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+    js_element_t * element = node->element;
 
-    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
+    js_type_t type = js_type( element );
+
+    if( type != js_type_object && type != js_type_array )
     {
-        return JS_FAILURE;
+        __js_node_forget( _document, node );
+
+        __js_element_destroy( _document, element );
+
+        return JS_TRUE;
     }
 
-    return JS_SUCCESSFUL;
+    if( __js_element_release( element ) != 0 )
+    {
+        __js_node_forget( _document, node );
+
+        __js_element_orphan( element, top );
+
+        return JS_TRUE;
+    }
+
+    node->next = frame;
+
+    _document->free_top = node;
+
+    return JS_TRUE;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_object_add_field_string( js_element_t * _documet, js_element_t * _element, js_string_t _key, const char * _value )
+js_bool_t js_free_incremental( js_element_t * _element, js_size_t _budget )
 {
-    js_size_t value_size = js_strlen( _value );
+    js_document_t * document = (js_document_t *)_element;
 
-    js_string_t value_string = {_value, value_size};
+    js_allocator_t * allocator = __js_document_allocator( document );
 
-    js_result_t result = js_object_add_field_stringn( _documet, _element, _key, value_string );
+    if( allocator->free == &__js_arena_free )
+    {
+        js_free( _element );
 
-    return result;
+        return JS_FALSE;
+    }
+
+    for( js_size_t step = 0; step != _budget; ++step )
+    {
+        if( __js_free_step( document ) == JS_FALSE )
+        {
+            __js_document_destroy( document );
+
+            return JS_FALSE;
+        }
+    }
+
+    return JS_TRUE;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_object_add_field_stringn( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_string_t _value )
+void js_reset( js_element_t * _element )
 {
-    js_document_t * document = (js_document_t *)_documet;
+    js_document_t * document = (js_document_t *)_element;
 
     js_allocator_t * allocator = __js_document_allocator( document );
 
-    js_element_string_t * value = document->string_create( allocator, _value );
+    if( allocator->free == &__js_arena_free )
+    {
+        js_arena_t * arena = (js_arena_t *)allocator->ud;
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+        __js_arena_rewind( arena, document );
+    }
+    else
+    {
+        __js_document_clear( document );
+    }
 
-    if( __js_object_add_string( document, _element, _key, (js_element_t *)value ) == JS_FAILURE )
+    document->object.size = 0;
+    document->object.keys = JS_NULLPTR;
+    document->object.values = JS_NULLPTR;
+    document->object.keys_last = JS_NULLPTR;
+    document->object.values_last = JS_NULLPTR;
+    document->meta.source.value = JS_NULLPTR;
+    document->meta.source.size = 0;
+    document->meta.hashed = JS_FALSE;
+
+    if( document->flags & js_flag_node_pool )
     {
-        return JS_FAILURE;
+        js_node_t * free = JS_NULLPTR;
+
+        for( js_block_t * block = document->free_block; block != JS_NULLPTR; block = block->prev )
+        {
+            for( js_size_t index = 0; index != JS_NODEBLOCK_SIZE; ++index )
+            {
+                js_node_t * node = block->nodes + index;
+
+                node->element = JS_NULLPTR;
+                node->next = free;
+
+                free = node;
+            }
+        }
+
+        document->free_node = free;
     }
 
-    return JS_SUCCESSFUL;
+    if( allocator->free == &__js_compact_free )
+    {
+        js_compact_t * compact = (js_compact_t *)allocator->ud;
+
+        compact->buffer.memory = (uint8_t *)document + __js_memory_align( sizeof( js_document_t ) );
+    }
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_object_add_field_array( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_element_t ** _array )
+js_result_t js_parse_into( js_element_t * _element, const char * _data, js_size_t _size, js_failed_fun_t _failed, void * _ud )
 {
-    js_document_t * document = (js_document_t *)_documet;
+    js_document_t * document = (js_document_t *)_element;
 
-    js_allocator_t * allocator = __js_document_allocator( document );
+    js_reset( _element );
 
-    js_element_array_t * array = __js_array_create( allocator );
+    const char * data_begin = _data;
+    const char * data_end = _data + _size;
 
-    JS_ALLOCATOR_MEMORY_CHECK( array, JS_FAILURE );
+    const char * data_root = js_strchr( data_begin, data_end, '{' );
 
-    if( __js_object_add_string( document, _element, _key, (js_element_t *)array ) == JS_FAILURE )
+    if( data_root == JS_NULLPTR )
     {
+        if( _failed != JS_NULLPTR )
+        {
+            _failed( data_begin, data_end, "parse root [begin]", _ud );
+        }
+
         return JS_FAILURE;
     }
 
-    *_array = (js_element_t *)array;
+    if( __js_parse_root( document, data_root, data_end, _failed, _ud ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
 
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_object_add_field_object( js_element_t * _documet, js_element_t * _element, js_string_t _key, js_element_t ** _object )
+typedef enum js_parser_state_e
 {
-    js_document_t * document = (js_document_t *)_documet;
+    js_parser_state_begin,
+    js_parser_state_value,
+    js_parser_state_separator,
+} js_parser_state_e;
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_parser_frame_t
+{
+    js_element_t * container;
+    const char * begin;
+    uint32_t state;
+} js_parser_frame_t;
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_parser_t
+{
+    js_allocator_t allocator;
+    js_document_t * document;
+    js_parse_status_t status;
 
-    js_allocator_t * allocator = __js_document_allocator( document );
+    const char * data;
+    const char * end;
 
-    js_element_object_t * object = __js_object_create( allocator );
+    js_failed_fun_t failed;
+    void * ud;
 
-    JS_ALLOCATOR_MEMORY_CHECK( object, JS_FAILURE );
+    js_parser_frame_t * frames;
+    js_size_t frames_size;
+    js_size_t frames_capacity;
 
-    if( __js_object_add_string( document, _element, _key, (js_element_t *)object ) == JS_FAILURE )
+    js_parser_frame_t frames_stack[JS_PARSER_STACK_SIZE];
+} js_parser_t;
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_parser_push( js_parser_t * _parser, js_element_t * _container, const char * _begin )
+{
+    if( _parser->frames_size == _parser->frames_capacity )
     {
-        return JS_FAILURE;
+        js_allocator_t * allocator = &_parser->allocator;
+
+        js_size_t capacity = _parser->frames_capacity * 2;
+
+        js_parser_frame_t * frames = (js_parser_frame_t *)allocator->alloc( capacity * sizeof( js_parser_frame_t ), allocator->ud );
+
+        JS_ALLOCATOR_MEMORY_CHECK( frames, JS_FAILURE );
+
+        js_memcpy( (char *)frames, (const char *)_parser->frames, _parser->frames_size * sizeof( js_parser_frame_t ) );
+
+        if( _parser->frames != _parser->frames_stack )
+        {
+            allocator->free( _parser->frames, allocator->ud );
+        }
+
+        _parser->frames = frames;
+        _parser->frames_capacity = capacity;
     }
 
-    *_object = (js_element_t *)object;
+    js_parser_frame_t * frame = _parser->frames + _parser->frames_size++;
+
+    frame->container = _container;
+    frame->begin = _begin;
+    frame->state = js_parser_state_begin;
 
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_array_push_null( js_element_t * _documet, js_element_t * _element )
+static void __js_parser_close( js_parser_t * _parser, const char * _close )
 {
-    js_document_t * document = (js_document_t *)_documet;
+    js_parser_frame_t * frame = _parser->frames + --_parser->frames_size;
 
-    js_allocator_t * allocator = __js_document_allocator( document );
+    _parser->data = _close + 1;
 
-    js_element_null_t * value = __js_null_create( allocator );
+    if( _parser->document->flags & js_flag_source_span )
+    {
+        __js_element_set_source( frame->container, frame->begin, _parser->data );
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_parser_value( js_parser_t * _parser, js_parser_frame_t * _frame )
+{
+    js_document_t * document = _parser->document;
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+    const char * data_iterator = _parser->data;
+
+    js_element_string_t * key = JS_NULLPTR;
+
+    if( js_type( _frame->container ) == js_type_object )
+    {
+        if( __js_parse_key( document, &data_iterator, _parser->end, _parser->failed, _parser->ud, &key ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+    }
 
-    if( __js_array_add( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    char token = key == JS_NULLPTR ? ']' : '}';
+
+    js_element_t * value;
+    if( __js_parse_element( document, &data_iterator, _parser->end, token, JS_TRUE, _parser->failed, _parser->ud, &value ) == JS_FAILURE )
     {
         return JS_FAILURE;
     }
 
+    if( key == JS_NULLPTR )
+    {
+        if( __js_array_add( document, _frame->container, value ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+    }
+    else
+    {
+        if( __js_object_add( document, _frame->container, key, value ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+    }
+
+    _frame->state = js_parser_state_separator;
+
+    _parser->data = data_iterator;
+
+    js_type_t type = js_type( value );
+
+    if( type == js_type_object || type == js_type_array )
+    {
+        if( __js_parser_push( _parser, value, data_iterator ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+    }
+
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_array_push_true( js_element_t * _documet, js_element_t * _element )
+static js_result_t __js_parser_advance( js_parser_t * _parser )
 {
-    js_document_t * document = (js_document_t *)_documet;
+    js_parser_frame_t * frame = _parser->frames + _parser->frames_size - 1;
 
-    js_allocator_t * allocator = __js_document_allocator( document );
+    char close = js_type( frame->container ) == js_type_object ? '}' : ']';
 
-    js_element_true_t * value = __js_true_create( allocator );
+    switch( frame->state )
+    {
+    case js_parser_state_begin:
+        {
+            const char * value_empty = js_strskip( _parser->data + 1, _parser->end, " \t\n\r" );
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+            if( value_empty != JS_NULLPTR && *value_empty == close )
+            {
+                __js_parser_close( _parser, value_empty );
+
+                return JS_SUCCESSFUL;
+            }
+
+            if( value_empty == JS_NULLPTR )
+            {
+                _parser->failed( _parser->data, _parser->end, "parse step [begin]", _parser->ud );
+
+                return JS_FAILURE;
+            }
+
+            _parser->data = value_empty;
+
+            frame->state = js_parser_state_value;
+        }break;
+    case js_parser_state_value:
+        {
+            if( __js_parser_value( _parser, frame ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+        }break;
+    case js_parser_state_separator:
+        {
+            const char * value_end = js_strskip( _parser->data, _parser->end, " \t\n\r" );
+
+            if( value_end == JS_NULLPTR || (*value_end != ',' && *value_end != close) )
+            {
+                _parser->failed( _parser->data, _parser->end, "parse step [separator]", _parser->ud );
+
+                return JS_FAILURE;
+            }
+
+            if( *value_end == close )
+            {
+                __js_parser_close( _parser, value_end );
+
+                return JS_SUCCESSFUL;
+            }
+
+            _parser->data = value_end + 1;
+
+            frame->state = js_parser_state_value;
+        }break;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_parser_create( js_allocator_t _allocator, js_flags_t _flags, const char * _data, js_size_t _size, js_failed_fun_t _failed, void * _ud, js_parser_t ** _parser )
+{
+    const char * data_begin = _data;
+    const char * data_end = _data + _size;
+
+    const char * data_root = js_strchr( data_begin, data_end, '{' );
 
-    if( __js_array_add( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    if( data_root == JS_NULLPTR )
     {
+        if( _failed != JS_NULLPTR )
+        {
+            _failed( data_begin, data_end, "parse root [begin]", _ud );
+        }
+
         return JS_FAILURE;
     }
 
+    js_document_t * document = __js_document_create( _allocator, _flags );
+
+    JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
+
+    js_parser_t * parser = JS_ALLOCATOR_NEW( &_allocator, js_parser_t );
+
+    JS_ALLOCATOR_MEMORY_CHECK( parser, JS_FAILURE );
+
+    parser->allocator = _allocator;
+    parser->document = document;
+    parser->status = js_parse_status_progress;
+
+    parser->data = data_root;
+    parser->end = data_end;
+
+    parser->failed = _failed;
+    parser->ud = _ud;
+
+    parser->frames = parser->frames_stack;
+    parser->frames_size = 0;
+    parser->frames_capacity = JS_PARSER_STACK_SIZE;
+
+    __js_parser_push( parser, (js_element_t *)document, data_root );
+
+    *_parser = parser;
+
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_array_push_false( js_element_t * _documet, js_element_t * _element )
+js_parse_status_t js_parse_step( js_parser_t * _parser, js_size_t _budget )
 {
-    js_document_t * document = (js_document_t *)_documet;
+    for( js_size_t step = 0; step != _budget && _parser->status == js_parse_status_progress; ++step )
+    {
+        if( __js_parser_advance( _parser ) == JS_FAILURE )
+        {
+            _parser->status = js_parse_status_failed;
+        }
+        else if( _parser->frames_size == 0 )
+        {
+            _parser->status = js_parse_status_done;
+        }
+    }
 
-    js_allocator_t * allocator = __js_document_allocator( document );
+    return _parser->status;
+}
+//////////////////////////////////////////////////////////////////////////
+js_element_t * js_parser_document( const js_parser_t * _parser )
+{
+    js_element_t * document = (js_element_t *)_parser->document;
 
-    js_element_false_t * value = __js_false_create( allocator );
+    return document;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_parser_destroy( js_parser_t * _parser )
+{
+    js_allocator_t allocator = _parser->allocator;
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+    if( _parser->frames != _parser->frames_stack )
+    {
+        allocator.free( _parser->frames, allocator.ud );
+    }
+
+    allocator.free( _parser, allocator.ud );
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_document_pool_slot_t
+{
+    js_bool_t owned;
+    js_document_t * documents[JS_DOCUMENT_POOL_CACHE_SIZE];
+
+    struct js_document_pool_slot_t * next;
+} js_document_pool_slot_t;
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_document_pool_t
+{
+    js_allocator_t allocator;
+    js_flags_t flags;
+    uint64_t id;
+
+    long lock;
+    js_document_t * free;
+    js_document_pool_slot_t * slots;
+    js_size_t blocks;
+} js_document_pool_t;
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_document_pool_local_t
+{
+    uint64_t id;
+    js_document_pool_slot_t * slot;
+} js_document_pool_local_t;
+//////////////////////////////////////////////////////////////////////////
+static uint64_t __js_document_pool_id = 0;
+//////////////////////////////////////////////////////////////////////////
+static JS_THREAD_LOCAL js_document_pool_local_t __js_document_pool_local[JS_DOCUMENT_POOL_LOCAL_SIZE];
+static JS_THREAD_LOCAL js_size_t __js_document_pool_local_next;
+//////////////////////////////////////////////////////////////////////////
+static void __js_document_pool_push( js_document_pool_t * _pool, js_document_t * _document )
+{
+    JS_ATOMIC_LOCK( &_pool->lock );
+
+    _document->pool_next = _pool->free;
+    _pool->free = _document;
+
+    JS_ATOMIC_UNLOCK( &_pool->lock );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_document_t * __js_document_pool_pop( js_document_pool_t * _pool )
+{
+    JS_ATOMIC_LOCK( &_pool->lock );
+
+    js_document_t * document = _pool->free;
+
+    if( document != JS_NULLPTR )
+    {
+        _pool->free = document->pool_next;
+    }
+
+    JS_ATOMIC_UNLOCK( &_pool->lock );
 
-    if( __js_array_add( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    if( document != JS_NULLPTR )
     {
-        return JS_FAILURE;
+        document->pool_next = JS_NULLPTR;
     }
 
-    return JS_SUCCESSFUL;
+    return document;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_array_push_boolean( js_element_t * _documet, js_element_t * _element, js_bool_t _value )
+static js_document_pool_local_t * __js_document_pool_local_find( const js_document_pool_t * _pool )
 {
-    if( _value == JS_TRUE )
+    for( js_size_t index = 0; index != JS_DOCUMENT_POOL_LOCAL_SIZE; ++index )
     {
-        js_result_t result = js_array_push_true( _documet, _element );
+        js_document_pool_local_t * local = __js_document_pool_local + index;
 
-        return result;
+        if( local->id == _pool->id )
+        {
+            return local;
+        }
     }
-    else
-    {
-        js_result_t result = js_array_push_false( _documet, _element );
 
-        return result;
-    }
+    return JS_NULLPTR;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_array_push_integer( js_element_t * _documet, js_element_t * _element, js_integer_t _value )
+static js_document_pool_slot_t * __js_document_pool_slot_claim( js_document_pool_t * _pool )
 {
-    js_document_t * document = (js_document_t *)_documet;
+    JS_ATOMIC_LOCK( &_pool->lock );
 
-    js_allocator_t * allocator = __js_document_allocator( document );
+    js_document_pool_slot_t * slot = _pool->slots;
 
-    js_element_integer_t * value = __js_integer_create( allocator, _value );
+    for( ; slot != JS_NULLPTR; slot = slot->next )
+    {
+        if( slot->owned == JS_FALSE )
+        {
+            slot->owned = JS_TRUE;
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+            break;
+        }
+    }
+
+    JS_ATOMIC_UNLOCK( &_pool->lock );
 
-    if( __js_array_add( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    if( slot != JS_NULLPTR )
     {
-        return JS_FAILURE;
+        return slot;
     }
 
-    return JS_SUCCESSFUL;
-}
-//////////////////////////////////////////////////////////////////////////
-js_result_t js_array_push_real( js_element_t * _documet, js_element_t * _element, js_real_t _value )
-{
-    js_document_t * document = (js_document_t *)_documet;
-
-    js_allocator_t * allocator = __js_document_allocator( document );
+    slot = JS_ALLOCATOR_NEW( &_pool->allocator, js_document_pool_slot_t );
 
-    js_element_real_t * value = __js_real_create( allocator, _value );
+    JS_ALLOCATOR_MEMORY_CHECK( slot, JS_NULLPTR );
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+    slot->owned = JS_TRUE;
 
-    if( __js_array_add( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    for( js_size_t index = 0; index != JS_DOCUMENT_POOL_CACHE_SIZE; ++index )
     {
-        return JS_FAILURE;
+        slot->documents[index] = JS_NULLPTR;
     }
 
-    return JS_SUCCESSFUL;
+    JS_ATOMIC_LOCK( &_pool->lock );
+
+    slot->next = _pool->slots;
+    _pool->slots = slot;
+
+    JS_ATOMIC_UNLOCK( &_pool->lock );
+
+    return slot;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_array_push_string( js_element_t * _documet, js_element_t * _element, const char * _value )
+static js_document_pool_slot_t * __js_document_pool_slot( js_document_pool_t * _pool, js_bool_t _create )
 {
-    js_size_t value_size = js_strlen( _value );
+    js_document_pool_local_t * local = __js_document_pool_local_find( _pool );
 
-    js_string_t value_string = {_value, value_size};
+    if( local != JS_NULLPTR )
+    {
+        return local->slot;
+    }
 
-    js_result_t result = js_array_push_stringn( _documet, _element, value_string );
+    if( _create == JS_FALSE )
+    {
+        return JS_NULLPTR;
+    }
 
-    return result;
+    js_document_pool_slot_t * slot = __js_document_pool_slot_claim( _pool );
+
+    JS_ALLOCATOR_MEMORY_CHECK( slot, JS_NULLPTR );
+
+    // an evicted entry keeps its slot owned, the pool still frees its documents on destroy
+    local = __js_document_pool_local + __js_document_pool_local_next % JS_DOCUMENT_POOL_LOCAL_SIZE;
+
+    ++__js_document_pool_local_next;
+
+    local->id = _pool->id;
+    local->slot = slot;
+
+    return slot;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_array_push_stringn( js_element_t * _documet, js_element_t * _element, js_string_t _value )
+static js_document_t * __js_document_pool_create( js_document_pool_t * _pool )
 {
-    js_document_t * document = (js_document_t *)_documet;
+    js_document_t * document = __js_document_create( _pool->allocator, _pool->flags );
 
-    js_allocator_t * allocator = __js_document_allocator( document );
+    JS_ALLOCATOR_MEMORY_CHECK( document, JS_NULLPTR );
 
-    js_element_string_t * value = document->string_create( allocator, _value );
+    js_allocator_t * allocator = __js_document_allocator( document );
 
-    JS_ALLOCATOR_MEMORY_CHECK( value, JS_FAILURE );
+    js_size_t blocks = JS_ATOMIC_LOAD_SIZE( &_pool->blocks );
 
-    if( __js_array_add( document, _element, (js_element_t *)value ) == JS_FAILURE )
+    for( js_size_t index = 1; index < blocks; ++index )
     {
-        return JS_FAILURE;
+        js_node_t * free;
+        js_block_t * block = __js_block_create( allocator, &free );
+
+        JS_ALLOCATOR_MEMORY_CHECK( block, JS_NULLPTR );
+
+        block->prev = document->free_block;
+        document->free_block = block;
+
+        block->nodes[0].next = document->free_node;
+        document->free_node = free;
     }
 
-    return JS_SUCCESSFUL;
+    return document;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_array_push_array( js_element_t * _documet, js_element_t * _element, js_element_t ** _array )
+js_result_t js_document_pool_create( js_allocator_t _allocator, js_flags_t _flags, js_document_pool_t ** _pool )
 {
-    js_document_t * document = (js_document_t *)_documet;
-
-    js_allocator_t * allocator = __js_document_allocator( document );
+    js_document_pool_t * pool = JS_ALLOCATOR_NEW( &_allocator, js_document_pool_t );
 
-    js_element_array_t * array = __js_array_create( allocator );
+    JS_ALLOCATOR_MEMORY_CHECK( pool, JS_FAILURE );
 
-    JS_ALLOCATOR_MEMORY_CHECK( array, JS_FAILURE );
+    pool->allocator = _allocator;
+    pool->flags = (_flags | js_flag_node_pool) & ~(js_flags_t)js_flag_compact;
+    pool->id = JS_ATOMIC_INCREMENT_U64( &__js_document_pool_id );
 
-    if( __js_array_add( document, _element, (js_element_t *)array ) == JS_FAILURE )
-    {
-        return JS_FAILURE;
-    }
+    pool->lock = 0;
+    pool->free = JS_NULLPTR;
+    pool->slots = JS_NULLPTR;
+    pool->blocks = 1;
 
-    *_array = (js_element_t *)array;
+    *_pool = pool;
 
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_array_push_object( js_element_t * _documet, js_element_t * _element, js_element_t ** _object )
+void js_document_pool_flush( js_document_pool_t * _pool )
 {
-    js_document_t * document = (js_document_t *)_documet;
-
-    js_allocator_t * allocator = __js_document_allocator( document );
+    js_document_pool_local_t * local = __js_document_pool_local_find( _pool );
 
-    js_element_object_t * object = __js_object_create( allocator );
+    if( local == JS_NULLPTR )
+    {
+        return;
+    }
 
-    JS_ALLOCATOR_MEMORY_CHECK( object, JS_FAILURE );
+    js_document_pool_slot_t * slot = local->slot;
 
-    if( __js_array_add( document, _element, (js_element_t *)object ) == JS_FAILURE )
+    for( js_size_t index = 0; index != JS_DOCUMENT_POOL_CACHE_SIZE; ++index )
     {
-        return JS_FAILURE;
+        js_document_t * document = slot->documents[index];
+
+        if( document == JS_NULLPTR )
+        {
+            continue;
+        }
+
+        slot->documents[index] = JS_NULLPTR;
+
+        __js_document_pool_push( _pool, document );
     }
 
-    *_object = (js_element_t *)object;
+    JS_ATOMIC_LOCK( &_pool->lock );
 
-    return JS_SUCCESSFUL;
+    slot->owned = JS_FALSE;
+
+    JS_ATOMIC_UNLOCK( &_pool->lock );
+
+    local->id = 0;
+    local->slot = JS_NULLPTR;
 }
 //////////////////////////////////////////////////////////////////////////
-void js_array_remove( js_element_t * _document, js_element_t * _element, js_size_t _index )
+void js_document_pool_destroy( js_document_pool_t * _pool )
 {
-    js_document_t * document = (js_document_t *)_document;
+    js_document_pool_local_t * local = __js_document_pool_local_find( _pool );
 
-    js_element_array_t * array = JS_CAST( js_element_array_t, _element );
+    if( local != JS_NULLPTR )
+    {
+        local->id = 0;
+        local->slot = JS_NULLPTR;
+    }
 
-    js_node_t * it = array->values;
+    js_allocator_t allocator = _pool->allocator;
 
-    for( js_size_t index = 0; index != _index; ++index )
+    for( js_document_pool_slot_t * slot = _pool->slots; slot != JS_NULLPTR; )
     {
-        JS_ASSERT( it->next != JS_NULLPTR, JS_CODE_FILE, JS_CODE_LINE );
+        for( js_size_t index = 0; index != JS_DOCUMENT_POOL_CACHE_SIZE; ++index )
+        {
+            js_document_t * document = slot->documents[index];
 
-        it = it->next;
-    }
+            if( document == JS_NULLPTR )
+            {
+                continue;
+            }
 
-    js_node_t * next = it->next;
+            js_free( (js_element_t *)document );
+        }
 
-    if( next != JS_NULLPTR )
-    {
-        it->next = next->next;
+        js_document_pool_slot_t * free_slot = slot;
+
+        slot = slot->next;
+
+        allocator.free( free_slot, allocator.ud );
     }
 
-    js_element_t * value = it->element;
+    for( js_document_t * document = _pool->free; document != JS_NULLPTR; )
+    {
+        js_document_t * free_document = document;
 
-    __js_element_destroy( document, value );
+        document = document->pool_next;
 
-    __js_node_destroy( document, it );
+        js_free( (js_element_t *)free_document );
+    }
 
-    --array->size;
+    allocator.free( _pool, allocator.ud );
 }
 //////////////////////////////////////////////////////////////////////////
-void js_array_clear( js_element_t * _document, js_element_t * _element )
+js_result_t js_document_pool_acquire( js_document_pool_t * _pool, js_element_t ** _element )
 {
-    js_document_t * document = (js_document_t *)_document;
+    js_document_pool_slot_t * slot = __js_document_pool_slot( _pool, JS_FALSE );
 
-    js_element_array_t * array = JS_CAST( js_element_array_t, _element );
+    if( slot != JS_NULLPTR )
+    {
+        for( js_size_t index = 0; index != JS_DOCUMENT_POOL_CACHE_SIZE; ++index )
+        {
+            js_document_t * document = slot->documents[index];
 
-    js_node_t * it = array->values;
+            if( document == JS_NULLPTR )
+            {
+                continue;
+            }
 
-    for( ; it != JS_NULLPTR; it = it->next )
-    {
-        js_element_t * value = it->element;
+            slot->documents[index] = JS_NULLPTR;
 
-        __js_element_destroy( document, value );
+            *_element = (js_element_t *)document;
 
-        __js_node_destroy( document, it );
+            return JS_SUCCESSFUL;
+        }
     }
 
-    array->values = JS_NULLPTR;
-    array->size = 0;
+    js_document_t * document = __js_document_pool_pop( _pool );
+
+    if( document == JS_NULLPTR )
+    {
+        document = __js_document_pool_create( _pool );
+
+        JS_ALLOCATOR_MEMORY_CHECK( document, JS_FAILURE );
+    }
+
+    *_element = (js_element_t *)document;
+
+    return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-void js_free( js_element_t * _element )
+void js_document_pool_release( js_document_pool_t * _pool, js_element_t * _element )
 {
     js_document_t * document = (js_document_t *)_element;
 
-    js_node_t * it_key = document->object.keys;
-    js_node_t * it_value = document->object.values;
+    js_reset( _element );
 
-    for( ; it_key != JS_NULLPTR; )
-    {
-        js_node_t * free_key = it_key;
-        js_node_t * free_value = it_value;
+    js_size_t blocks = 0;
 
-        it_key = it_key->next;
-        it_value = it_value->next;
-
-        __js_node_destroy( document, free_key );
-        __js_node_destroy( document, free_value );
+    for( const js_block_t * block = document->free_block; block != JS_NULLPTR; block = block->prev )
+    {
+        ++blocks;
     }
 
-    js_allocator_t * allocator = __js_document_allocator( document );
+    JS_ATOMIC_STORE_SIZE( &_pool->blocks, blocks );
 
-    js_flags_t flags = document->flags;
+    js_document_pool_slot_t * slot = __js_document_pool_slot( _pool, JS_TRUE );
 
-    if( flags & js_flag_node_pool )
+    if( slot != JS_NULLPTR )
     {
-        for( js_block_t * block = document->free_block; block != JS_NULLPTR; )
+        for( js_size_t index = 0; index != JS_DOCUMENT_POOL_CACHE_SIZE; ++index )
         {
-            js_block_t * free_block = block;
-            block = block->prev;
+            if( slot->documents[index] != JS_NULLPTR )
+            {
+                continue;
+            }
 
-            allocator->free( free_block, allocator->ud );
+            slot->documents[index] = document;
+
+            return;
         }
     }
 
-    allocator->free( document, allocator->ud );
+    __js_document_pool_push( _pool, document );
 }
 //////////////////////////////////////////////////////////////////////////
 js_type_t js_type( const js_element_t * _element )
@@ -1890,6 +4610,27 @@ void js_get_string( const js_element_t * _element, js_string_t * _value )
     *_value = el->value;
 }
 //////////////////////////////////////////////////////////////////////////
+js_bool_t js_get_source( const js_element_t * _element, js_string_t * const _source )
+{
+    const js_element_meta_t * meta = __js_element_meta( _element );
+
+    if( meta == JS_NULLPTR )
+    {
+        return JS_FALSE;
+    }
+
+    js_string_t source = meta->source;
+
+    if( source.value == JS_NULLPTR )
+    {
+        return JS_FALSE;
+    }
+
+    *_source = source;
+
+    return JS_TRUE;
+}
+//////////////////////////////////////////////////////////////////////////
 js_size_t js_array_size( const js_element_t * _element )
 {
     const js_element_array_t * array = JS_CONST_CAST( js_element_array_t, _element );
@@ -1938,7 +4679,7 @@ js_element_t * js_object_get( const js_element_t * _element, const char * _key )
         const char * key_value = key->value.value;
         js_size_t key_size = key->value.size;
 
-        if( js_strncmp( _key, key_value, key_size ) == JS_FALSE )
+        if( js_strncmp( _key, key_value, key_size ) == JS_FALSE || _key[key_size] != '\0' )
         {
             continue;
         }
@@ -1975,6 +4716,79 @@ js_element_t * js_object_getn( const js_element_t * _object, js_string_t _key )
     return JS_NULLPTR;
 }
 //////////////////////////////////////////////////////////////////////////
+js_element_t * js_array_edit( js_element_t * _document, js_element_t * _element, js_size_t _index )
+{
+    js_document_t * document = (js_document_t *)_document;
+
+    if( __js_element_writable( document, _element ) == JS_FALSE )
+    {
+        return JS_NULLPTR;
+    }
+
+    js_element_array_t * array = JS_CAST( js_element_array_t, _element );
+
+    js_node_t * it_value = array->values;
+
+    for( js_size_t index = 0; it_value != JS_NULLPTR; it_value = it_value->next, ++index )
+    {
+        if( index != _index )
+        {
+            continue;
+        }
+
+        if( __js_unshare_element( document, _element, it_value ) == JS_FAILURE )
+        {
+            return JS_NULLPTR;
+        }
+
+        js_element_t * value = it_value->element;
+
+        return value;
+    }
+
+    return JS_NULLPTR;
+}
+//////////////////////////////////////////////////////////////////////////
+js_element_t * js_object_edit( js_element_t * _document, js_element_t * _element, const char * _key )
+{
+    js_document_t * document = (js_document_t *)_document;
+
+    if( __js_element_writable( document, _element ) == JS_FALSE )
+    {
+        return JS_NULLPTR;
+    }
+
+    js_element_object_t * object = JS_CAST( js_element_object_t, _element );
+
+    js_string_t key_string;
+    key_string.value = _key;
+    key_string.size = js_strlen( _key );
+
+    const js_node_t * it_key = object->keys;
+    js_node_t * it_value = object->values;
+
+    for( ; it_key != JS_NULLPTR; it_key = it_key->next, it_value = it_value->next )
+    {
+        const js_element_string_t * key = JS_CONST_CAST( js_element_string_t, it_key->element );
+
+        if( js_strzcmp( key_string, key->value ) == JS_FALSE )
+        {
+            continue;
+        }
+
+        if( __js_unshare_element( document, _element, it_value ) == JS_FAILURE )
+        {
+            return JS_NULLPTR;
+        }
+
+        js_element_t * value = it_value->element;
+
+        return value;
+    }
+
+    return JS_NULLPTR;
+}
+//////////////////////////////////////////////////////////////////////////
 js_result_t js_array_visit( const js_element_t * _element, js_array_visitor_fun_t _visitor, void * _ud )
 {
     const js_element_array_t * array = JS_CONST_CAST( js_element_array_t, _element );
@@ -2060,4 +4874,49 @@ void js_object_foreach( const js_element_t * _element, js_object_foreach_fun_t _
         ++index;
     }
 }
+//////////////////////////////////////////////////////////////////////////
+void js_array_begin( const js_element_t * _element, js_iterator_t * const _iterator )
+{
+    const js_element_array_t * array = JS_CONST_CAST( js_element_array_t, _element );
+
+    _iterator->key = JS_NULLPTR;
+    _iterator->value = array->values;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_object_begin( const js_element_t * _element, js_iterator_t * const _iterator )
+{
+    const js_element_object_t * object = JS_CONST_CAST( js_element_object_t, _element );
+
+    _iterator->key = object->keys;
+    _iterator->value = object->values;
+}
+//////////////////////////////////////////////////////////////////////////
+js_bool_t js_iterator_next( js_iterator_t * _iterator, const js_element_t ** _key, const js_element_t ** _value )
+{
+    const js_node_t * it_value = (const js_node_t *)_iterator->value;
+
+    if( it_value == JS_NULLPTR )
+    {
+        return JS_FALSE;
+    }
+
+    const js_node_t * it_key = (const js_node_t *)_iterator->key;
+
+    if( it_key != JS_NULLPTR )
+    {
+        *_key = it_key->element;
+
+        _iterator->key = it_key->next;
+    }
+    else
+    {
+        *_key = JS_NULLPTR;
+    }
+
+    *_value = it_value->element;
+
+    _iterator->value = it_value->next;
+
+    return JS_TRUE;
+}
 //////////////////////////////////////////////////////////////////////////
\ No newline at end of file
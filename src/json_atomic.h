@@ -0,0 +1,32 @@
+#ifndef JSON_ATOMIC_H_
+#define JSON_ATOMIC_H_
+
+#include "json/json_config.h"
+
+#ifndef JS_ATOMIC_LOCK
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+
+#       define JS_ATOMIC_LOCK(Ptr) while( _InterlockedExchange((volatile long *)(Ptr), 1) != 0 ) {}
+#       define JS_ATOMIC_UNLOCK(Ptr) _InterlockedExchange((volatile long *)(Ptr), 0)
+#       define JS_ATOMIC_INCREMENT_U64(Ptr) ((uint64_t)_InterlockedIncrement64((volatile long long *)(Ptr)))
+#       define JS_ATOMIC_LOAD_SIZE(Ptr) (*(volatile js_size_t *)(Ptr))
+#       define JS_ATOMIC_STORE_SIZE(Ptr, Value) (*(volatile js_size_t *)(Ptr) = (Value))
+#   else
+#       define JS_ATOMIC_LOCK(Ptr) while( __atomic_exchange_n((Ptr), 1, __ATOMIC_ACQUIRE) != 0 ) {}
+#       define JS_ATOMIC_UNLOCK(Ptr) __atomic_store_n((Ptr), 0, __ATOMIC_RELEASE)
+#       define JS_ATOMIC_INCREMENT_U64(Ptr) __atomic_add_fetch((Ptr), 1, __ATOMIC_RELAXED)
+#       define JS_ATOMIC_LOAD_SIZE(Ptr) __atomic_load_n((Ptr), __ATOMIC_RELAXED)
+#       define JS_ATOMIC_STORE_SIZE(Ptr, Value) __atomic_store_n((Ptr), (Value), __ATOMIC_RELAXED)
+#   endif
+#endif
+
+#ifndef JS_THREAD_LOCAL
+#   if defined(_MSC_VER)
+#       define JS_THREAD_LOCAL __declspec(thread)
+#   else
+#       define JS_THREAD_LOCAL __thread
+#   endif
+#endif
+
+#endif
\ No newline at end of file
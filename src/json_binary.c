@@ -1,7 +1,31 @@
 #include "json/json_binary.h"
 
-//////////////////////////////////////////////////////////////////////////
-static void __binary_write_element( js_binary_ctx_t * _ctx, const js_element_t * _element );
+#include "json_string.h"
+
+#ifndef JS_BINARY_TABLE_THRESHOLD
+#define JS_BINARY_TABLE_THRESHOLD 16
+#endif
+
+#ifndef JS_BINARY_STRING_TABLE_SIZE
+#define JS_BINARY_STRING_TABLE_SIZE 256
+#endif
+
+#ifndef JS_BINARY_STRING_VALUE_MAX_SIZE
+#define JS_BINARY_STRING_VALUE_MAX_SIZE 32
+#endif
+
+#ifndef JS_BINARY_STRING_KEY_MAX_SIZE
+#define JS_BINARY_STRING_KEY_MAX_SIZE 65536
+#endif
+
+#ifndef JS_BINARY_STAGE_SIZE
+#define JS_BINARY_STAGE_SIZE 1024
+#endif
+
+#define JS_BINARY_SMALL_INTEGER_MIN (-16)
+#define JS_BINARY_SMALL_INTEGER_MAX (111)
+#define JS_BINARY_VARINT_MAX_SIZE 10
+
 //////////////////////////////////////////////////////////////////////////
 typedef enum js_binary_type_e
 {
@@ -20,197 +44,2632 @@ typedef enum js_binary_type_e
     js_binary_type_array,
     js_binary_type_dict_z,
     js_binary_type_dict,
+    js_binary_type_header,
+    js_binary_type_array_table,
+    js_binary_type_dict_table,
+    js_binary_type_integer_varint,
+    js_binary_type_string_ref,
+    js_binary_type_array_table64,
+    js_binary_type_dict_table64,
+    js_binary_type_integer_small = 0x80,
 } js_binary_type_e;
 //////////////////////////////////////////////////////////////////////////
-static void __binary_write_type( js_binary_ctx_t * _ctx, js_binary_type_e _type )
+static js_bool_t __binary_is_skippable( js_binary_flags_t _flags )
 {
-    uint8_t type8 = (uint8_t)_type;
-    _ctx->write( &type8, sizeof( uint8_t ), _ctx->ud );
+    if( _flags & (js_binary_flag_skippable | js_binary_flag_table) )
+    {
+        return JS_TRUE;
+    }
+
+    return JS_FALSE;
 }
 //////////////////////////////////////////////////////////////////////////
-static void __binary_write_size( js_binary_ctx_t * _ctx, js_size_t _size )
+static js_bool_t __binary_is_strings( js_binary_flags_t _flags )
 {
-    if( _size < 255 )
+    if( _flags & (js_binary_flag_strings | js_binary_flag_string_values) )
     {
-        uint8_t size8 = (uint8_t)_size;
-        _ctx->write( &size8, sizeof( uint8_t ), _ctx->ud );
+        return JS_TRUE;
     }
-    else
+
+    return JS_FALSE;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __binary_is_compact( js_binary_flags_t _flags )
+{
+    if( _flags & js_binary_flag_compact )
     {
-        const uint8_t size255 = 255;
-        _ctx->write( &size255, sizeof( uint8_t ), _ctx->ud );
+        return JS_TRUE;
+    }
 
-        uint32_t size32 = (uint32_t)_size;
-        _ctx->write( &size32, sizeof( uint32_t ), _ctx->ud );
+    return JS_FALSE;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __binary_is_small_integer( js_integer_t _value )
+{
+    if( _value >= JS_BINARY_SMALL_INTEGER_MIN && _value <= JS_BINARY_SMALL_INTEGER_MAX )
+    {
+        return JS_TRUE;
     }
+
+    return JS_FALSE;
 }
 //////////////////////////////////////////////////////////////////////////
-static void __binary_write_integer( js_binary_ctx_t * _ctx, const js_element_t * _element )
+static uint64_t __binary_zigzag_encode( js_integer_t _value )
 {
-    js_integer_t value = js_get_integer( _element );
+    uint64_t value = ((uint64_t)_value << 1) ^ (uint64_t)(_value >> 63);
+
+    return value;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_integer_t __binary_zigzag_decode( uint64_t _value )
+{
+    js_integer_t value = (js_integer_t)(_value >> 1) ^ -(js_integer_t)(_value & 1);
+
+    return value;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_varint_size( uint64_t _value )
+{
+    js_size_t size = 1;
 
-    if( value == 0 )
+    while( _value >= 0x80 )
     {
-        __binary_write_type( _ctx, js_binary_type_integer_z );
+        _value >>= 7;
+
+        ++size;
     }
-    else if( value == 1 )
+
+    return size;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __binary_is_table( js_binary_flags_t _flags, js_size_t _size )
+{
+    if( (_flags & js_binary_flag_table) && _size >= JS_BINARY_TABLE_THRESHOLD )
     {
-        __binary_write_type( _ctx, js_binary_type_integer_1 );
+        return JS_TRUE;
     }
-    else
+
+    return JS_FALSE;
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_binary_string_t
+{
+    js_string_t value;
+    uint32_t hash;
+    uint32_t count;
+    uint32_t index;
+} js_binary_string_t;
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_binary_strings_t
+{
+    js_binary_string_t entries[JS_BINARY_STRING_TABLE_SIZE];
+    js_size_t size;
+    js_size_t count;
+} js_binary_strings_t;
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_binary_extent_t
+{
+    js_size_t values;
+    js_size_t containers;
+} js_binary_extent_t;
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_binary_writer_t
+{
+    js_binary_ex_ctx_t * ctx;
+    js_binary_flags_t flags;
+    js_binary_strings_t * strings;
+    uint8_t * stage_begin;
+    uint8_t * stage;
+    uint8_t * stage_end;
+    js_binary_extent_t * extents;
+    js_size_t extents_size;
+    js_size_t extent;
+    js_bool_t overflow;
+    js_bool_t failed;
+} js_binary_writer_t;
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_element( js_binary_writer_t * _writer, const js_element_t * _element );
+static js_size_t __binary_measure_element( js_binary_writer_t * _writer, const js_element_t * _element );
+//////////////////////////////////////////////////////////////////////////
+static js_binary_string_t * __binary_strings_find( js_binary_strings_t * _strings, js_string_t _value, uint32_t _hash )
+{
+    js_size_t mask = JS_BINARY_STRING_TABLE_SIZE - 1;
+
+    for( js_size_t probe = 0; probe != JS_BINARY_STRING_TABLE_SIZE; ++probe )
     {
-        __binary_write_type( _ctx, js_binary_type_integer );
-        _ctx->write( &value, sizeof( js_integer_t ), _ctx->ud );
+        js_binary_string_t * entry = _strings->entries + ((_hash + probe) & mask);
+
+        if( entry->value.value == JS_NULLPTR )
+        {
+            return entry;
+        }
+
+        if( entry->hash == _hash && js_strzcmp( entry->value, _value ) == JS_TRUE )
+        {
+            return entry;
+        }
     }
+
+    return JS_NULLPTR;
 }
 //////////////////////////////////////////////////////////////////////////
-static void __binary_write_real( js_binary_ctx_t * _ctx, const js_element_t * _element )
+static void __binary_strings_add( js_binary_strings_t * _strings, js_string_t _value )
 {
-    js_real_t value = js_get_real( _element );
+    if( _value.size == 0 || _value.size > JS_BINARY_STRING_KEY_MAX_SIZE )
+    {
+        return;
+    }
 
-    if( value == (js_real_t)0.0 )
+    uint32_t hash = js_strhash( _value );
+
+    js_binary_string_t * entry = __binary_strings_find( _strings, _value, hash );
+
+    if( entry == JS_NULLPTR )
     {
-        __binary_write_type( _ctx, js_binary_type_real_z );
+        return;
     }
-    else if( value == (js_real_t)1.0 )
+
+    if( entry->value.value != JS_NULLPTR )
     {
-        __binary_write_type( _ctx, js_binary_type_real_1 );
+        ++entry->count;
+
+        return;
     }
-    else
+
+    if( _strings->size * 4 >= JS_BINARY_STRING_TABLE_SIZE * 3 )
+    {
+        return;
+    }
+
+    entry->value = _value;
+    entry->hash = hash;
+    entry->count = 1;
+    entry->index = 0;
+
+    ++_strings->size;
+}
+//////////////////////////////////////////////////////////////////////////
+static const js_binary_string_t * __binary_strings_lookup( const js_binary_writer_t * _writer, js_string_t _value )
+{
+    if( _writer->strings == JS_NULLPTR || _value.size == 0 )
     {
-        __binary_write_type( _ctx, js_binary_type_real );
-        _ctx->write( &value, sizeof( js_real_t ), _ctx->ud );
+        return JS_NULLPTR;
     }
+
+    uint32_t hash = js_strhash( _value );
+
+    const js_binary_string_t * entry = __binary_strings_find( _writer->strings, _value, hash );
+
+    if( entry == JS_NULLPTR || entry->count < 2 )
+    {
+        return JS_NULLPTR;
+    }
+
+    return entry;
 }
 //////////////////////////////////////////////////////////////////////////
-static void __binary_write_string( js_binary_ctx_t * _ctx, const js_element_t * _element )
+static void __binary_flush( js_binary_writer_t * _writer )
 {
-    js_string_t str;
-    js_get_string( _element, &str );
+    js_binary_ex_ctx_t * ctx = _writer->ctx;
 
-    if( str.size == 0 )
+    if( ctx->buffer != JS_NULLPTR )
     {
-        __binary_write_type( _ctx, js_binary_type_string_z );
+        ctx->buffer->memory = _writer->stage;
+
+        return;
+    }
 
+    if( _writer->stage == _writer->stage_begin )
+    {
         return;
     }
 
-    __binary_write_type( _ctx, js_binary_type_string );
+    ctx->write( _writer->stage_begin, _writer->stage - _writer->stage_begin, ctx->ud );
 
-    __binary_write_size( _ctx, str.size );
-    _ctx->write( str.value, str.size, _ctx->ud );
+    _writer->stage = _writer->stage_begin;
 }
 //////////////////////////////////////////////////////////////////////////
-static void __binary_write_array_foreach( js_size_t _index, const js_element_t * _value, void * _ud )
+static void __binary_write( js_binary_writer_t * _writer, const void * _buffer, js_size_t _size )
 {
-    JS_UNUSED( _index );
+    if( (js_size_t)(_writer->stage_end - _writer->stage) >= _size )
+    {
+        js_memcpy( (char *)_writer->stage, (const char *)_buffer, _size );
+
+        _writer->stage += _size;
+
+        return;
+    }
+
+    js_binary_ex_ctx_t * ctx = _writer->ctx;
+
+    if( ctx->buffer != JS_NULLPTR )
+    {
+        _writer->stage = _writer->stage_end;
+        _writer->overflow = JS_TRUE;
+
+        return;
+    }
+
+    __binary_flush( _writer );
 
-    js_binary_ctx_t * ctx = (js_binary_ctx_t *)_ud;
+    if( (js_size_t)(_writer->stage_end - _writer->stage) < _size )
+    {
+        ctx->write( _buffer, _size, ctx->ud );
+
+        return;
+    }
 
-    __binary_write_element( ctx, _value );
+    js_memcpy( (char *)_writer->stage, (const char *)_buffer, _size );
+
+    _writer->stage += _size;
 }
 //////////////////////////////////////////////////////////////////////////
-static void __binary_write_array( js_binary_ctx_t * _ctx, const js_element_t * _element )
+static void __binary_write_byte( js_binary_writer_t * _writer, uint8_t _value )
 {
-    js_size_t size = js_array_size( _element );
-
-    if( size == 0 )
+    if( _writer->stage != _writer->stage_end )
     {
-        __binary_write_type( _ctx, js_binary_type_array_z );
+        *_writer->stage++ = _value;
 
         return;
     }
 
-    __binary_write_type( _ctx, js_binary_type_array );
+    __binary_write( _writer, &_value, sizeof( uint8_t ) );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_type( js_binary_writer_t * _writer, js_binary_type_e _type )
+{
+    __binary_write_byte( _writer, (uint8_t)_type );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_varint( js_binary_writer_t * _writer, uint64_t _value )
+{
+    uint8_t bytes[JS_BINARY_VARINT_MAX_SIZE];
+
+    js_size_t size = 0;
+
+    while( _value >= 0x80 )
+    {
+        bytes[size++] = (uint8_t)(_value | 0x80);
+
+        _value >>= 7;
+    }
 
-    __binary_write_size( _ctx, size );
+    bytes[size++] = (uint8_t)_value;
 
-    js_array_foreach( _element, &__binary_write_array_foreach, _ctx );
+    __binary_write( _writer, bytes, size );
 }
 //////////////////////////////////////////////////////////////////////////
-static void __binary_write_object_foreach( js_size_t _index, const js_element_t * _key, const js_element_t * _value, void * _ud )
+static void __binary_write_size( js_binary_writer_t * _writer, js_size_t _size )
 {
-    JS_UNUSED( _index );
+    if( __binary_is_compact( _writer->flags ) == JS_TRUE )
+    {
+        __binary_write_varint( _writer, (uint64_t)_size );
+    }
+    else if( _size < 255 )
+    {
+        __binary_write_byte( _writer, (uint8_t)_size );
+    }
+    else
+    {
+        __binary_write_byte( _writer, 255 );
+
+        if( (uint64_t)_size < (uint64_t)UINT32_MAX )
+        {
+            uint32_t size32 = (uint32_t)_size;
+            __binary_write( _writer, &size32, sizeof( uint32_t ) );
+        }
+        else
+        {
+            uint32_t escape32 = UINT32_MAX;
+            __binary_write( _writer, &escape32, sizeof( uint32_t ) );
+
+            uint64_t size64 = (uint64_t)_size;
+            __binary_write( _writer, &size64, sizeof( uint64_t ) );
+        }
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_u32( js_binary_writer_t * _writer, uint32_t _value )
+{
+    __binary_write( _writer, &_value, sizeof( uint32_t ) );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_measure_size( js_binary_flags_t _flags, js_size_t _size )
+{
+    if( __binary_is_compact( _flags ) == JS_TRUE )
+    {
+        js_size_t size = __binary_varint_size( (uint64_t)_size );
+
+        return size;
+    }
 
-    js_binary_ctx_t * ctx = (js_binary_ctx_t *)_ud;
+    if( _size < 255 )
+    {
+        return sizeof( uint8_t );
+    }
 
-    __binary_write_string( ctx, _key );
+    if( (uint64_t)_size < (uint64_t)UINT32_MAX )
+    {
+        return sizeof( uint8_t ) + sizeof( uint32_t );
+    }
 
-    __binary_write_element( ctx, _value );
+    return sizeof( uint8_t ) + sizeof( uint32_t ) + sizeof( uint64_t );
 }
 //////////////////////////////////////////////////////////////////////////
-static void __binary_write_object( js_binary_ctx_t * _ctx, const js_element_t * _element )
+static js_size_t __binary_measure_string( const js_binary_writer_t * _writer, js_string_t _value )
 {
-    js_size_t root_size = js_object_size( _element );
+    if( _value.size == 0 )
+    {
+        return sizeof( uint8_t );
+    }
 
-    if( root_size == 0 )
+    const js_binary_string_t * entry = __binary_strings_lookup( _writer, _value );
+
+    if( entry != JS_NULLPTR )
     {
-        __binary_write_type( _ctx, js_binary_type_dict_z );
+        js_size_t size = sizeof( uint8_t ) + __binary_varint_size( entry->index );
 
-        return;
+        return size;
+    }
+
+    js_size_t size = sizeof( uint8_t ) + __binary_measure_size( _writer->flags, _value.size ) + _value.size;
+
+    return size;
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_binary_measure_t
+{
+    js_binary_writer_t * writer;
+    js_size_t size;
+} js_binary_measure_t;
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_table_offset_size( js_size_t _values )
+{
+    if( (uint64_t)_values > (uint64_t)UINT32_MAX )
+    {
+        return sizeof( uint64_t );
+    }
+
+    return sizeof( uint32_t );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_measure_table( js_binary_flags_t _flags, js_size_t _size, js_size_t _values, js_size_t _hash )
+{
+    if( __binary_is_table( _flags, _size ) == JS_FALSE )
+    {
+        return 0;
     }
 
-    __binary_write_type( _ctx, js_binary_type_dict );
+    js_size_t table = _size * (_hash + __binary_table_offset_size( _values ));
+
+    return table;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_measure_container( const js_binary_writer_t * _writer, js_size_t _size, js_size_t _content )
+{
+    js_size_t size = sizeof( uint8_t ) + __binary_measure_size( _writer->flags, _size ) + _content;
 
-    __binary_write_size( _ctx, root_size );
+    if( __binary_is_skippable( _writer->flags ) == JS_TRUE )
+    {
+        size += __binary_measure_size( _writer->flags, _content );
+    }
 
-    js_object_foreach( _element, &__binary_write_object_foreach, _ctx );
+    return size;
 }
 //////////////////////////////////////////////////////////////////////////
-static void __binary_write_element( js_binary_ctx_t * _ctx, const js_element_t * _element )
+static js_size_t __binary_measure_value( const js_binary_writer_t * _writer, const js_element_t * _element )
 {
     js_type_t type = js_type( _element );
 
     switch( type )
     {
     case js_type_null:
-        {
-            __binary_write_type( _ctx, js_binary_type_null );
-        }break;
     case js_type_false:
-        {
-            __binary_write_type( _ctx, js_binary_type_false );
-        }break;
     case js_type_true:
+    case js_type_array:
+    case js_type_object:
         {
-            __binary_write_type( _ctx, js_binary_type_true );
+            return sizeof( uint8_t );
         }break;
     case js_type_integer:
         {
-            __binary_write_integer( _ctx, _element );            
+            js_integer_t value = js_get_integer( _element );
+
+            if( __binary_is_compact( _writer->flags ) == JS_TRUE )
+            {
+                if( __binary_is_small_integer( value ) == JS_TRUE )
+                {
+                    return sizeof( uint8_t );
+                }
+
+                uint64_t zigzag = __binary_zigzag_encode( value );
+
+                js_size_t size = sizeof( uint8_t ) + __binary_varint_size( zigzag );
+
+                return size;
+            }
+
+            if( value == 0 || value == 1 )
+            {
+                return sizeof( uint8_t );
+            }
+
+            return sizeof( uint8_t ) + sizeof( js_integer_t );
         }break;
     case js_type_real:
         {
-            __binary_write_real( _ctx, _element );
+            js_real_t value = js_get_real( _element );
+
+            if( value == (js_real_t)0.0 || value == (js_real_t)1.0 )
+            {
+                return sizeof( uint8_t );
+            }
+
+            return sizeof( uint8_t ) + sizeof( js_real_t );
         }break;
     case js_type_string:
         {
-            __binary_write_string( _ctx, _element );
-        }break;
-    case js_type_array:
-        {
-            __binary_write_array( _ctx, _element );
-        }break;
-    case js_type_object:
-        {
-            __binary_write_object( _ctx, _element );
+            js_string_t str;
+            js_get_string( _element, &str );
+
+            js_size_t size = __binary_measure_string( _writer, str );
+
+            return size;
         }break;
     }
+
+    return 0;
 }
 //////////////////////////////////////////////////////////////////////////
-void js_binary( const js_element_t * _element, js_binary_ctx_t * _ctx )
+static void __binary_measure_array_foreach( js_size_t _index, const js_element_t * _value, void * _ud )
 {
-    js_size_t root_size = js_object_size( _element );
+    JS_UNUSED( _index );
 
-    if( root_size == 0 )
+    js_binary_measure_t * measure = (js_binary_measure_t *)_ud;
+
+    measure->size += __binary_measure_element( measure->writer, _value );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_measure_object_foreach( js_size_t _index, const js_element_t * _key, const js_element_t * _value, void * _ud )
+{
+    JS_UNUSED( _index );
+
+    js_binary_measure_t * measure = (js_binary_measure_t *)_ud;
+
+    js_string_t key;
+    js_get_string( _key, &key );
+
+    measure->size += __binary_measure_string( measure->writer, key );
+    measure->size += __binary_measure_element( measure->writer, _value );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_measure_array( js_binary_writer_t * _writer, const js_element_t * _element, js_size_t _size )
+{
+    js_size_t index = _writer->extents_size++;
+
+    js_binary_measure_t measure;
+    measure.writer = _writer;
+    measure.size = 0;
+
+    js_array_foreach( _element, &__binary_measure_array_foreach, &measure );
+
+    js_binary_extent_t * extent = _writer->extents + index;
+    extent->values = measure.size;
+    extent->containers = _writer->extents_size - index;
+
+    js_size_t content = __binary_measure_table( _writer->flags, _size, measure.size, 0 ) + measure.size;
+
+    js_size_t container = __binary_measure_container( _writer, _size, content );
+
+    return container;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_measure_object( js_binary_writer_t * _writer, const js_element_t * _element, js_size_t _size )
+{
+    js_size_t index = _writer->extents_size++;
+
+    js_binary_measure_t measure;
+    measure.writer = _writer;
+    measure.size = 0;
+
+    js_object_foreach( _element, &__binary_measure_object_foreach, &measure );
+
+    js_binary_extent_t * extent = _writer->extents + index;
+    extent->values = measure.size;
+    extent->containers = _writer->extents_size - index;
+
+    js_size_t content = __binary_measure_table( _writer->flags, _size, measure.size, sizeof( uint32_t ) ) + measure.size;
+
+    js_size_t container = __binary_measure_container( _writer, _size, content );
+
+    return container;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_measure_element( js_binary_writer_t * _writer, const js_element_t * _element )
+{
+    js_type_t type = js_type( _element );
+
+    if( type == js_type_array )
     {
-        return;
+        js_size_t size = js_array_size( _element );
+
+        if( size != 0 )
+        {
+            js_size_t container = __binary_measure_array( _writer, _element, size );
+
+            return container;
+        }
+    }
+    else if( type == js_type_object )
+    {
+        js_size_t size = js_object_size( _element );
+
+        if( size != 0 )
+        {
+            js_size_t container = __binary_measure_object( _writer, _element, size );
+
+            return container;
+        }
     }
 
-    __binary_write_type( _ctx, js_binary_type_dict );
+    js_size_t value = __binary_measure_value( _writer, _element );
+
+    return value;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_measure_extent( const js_binary_writer_t * _writer, js_size_t _size, js_size_t _hash, js_size_t * const _extent )
+{
+    const js_binary_extent_t * extent = _writer->extents + *_extent;
+
+    *_extent += extent->containers;
+
+    js_size_t content = __binary_measure_table( _writer->flags, _size, extent->values, _hash ) + extent->values;
+
+    js_size_t container = __binary_measure_container( _writer, _size, content );
+
+    return container;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_measure_stored( const js_binary_writer_t * _writer, const js_element_t * _element, js_size_t * const _extent )
+{
+    js_type_t type = js_type( _element );
 
-    __binary_write_size( _ctx, root_size );
+    if( type == js_type_array )
+    {
+        js_size_t size = js_array_size( _element );
+
+        if( size != 0 )
+        {
+            js_size_t container = __binary_measure_extent( _writer, size, 0, _extent );
+
+            return container;
+        }
+    }
+    else if( type == js_type_object )
+    {
+        js_size_t size = js_object_size( _element );
+
+        if( size != 0 )
+        {
+            js_size_t container = __binary_measure_extent( _writer, size, sizeof( uint32_t ), _extent );
+
+            return container;
+        }
+    }
+
+    js_size_t value = __binary_measure_value( _writer, _element );
+
+    return value;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_count_array_foreach( js_size_t _index, const js_element_t * _value, void * _ud );
+static void __binary_count_object_foreach( js_size_t _index, const js_element_t * _key, const js_element_t * _value, void * _ud );
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __binary_count_element( const js_element_t * _element )
+{
+    js_type_t type = js_type( _element );
+
+    js_size_t count = 0;
+
+    if( type == js_type_array && js_array_size( _element ) != 0 )
+    {
+        count = 1;
+
+        js_array_foreach( _element, &__binary_count_array_foreach, &count );
+    }
+    else if( type == js_type_object && js_object_size( _element ) != 0 )
+    {
+        count = 1;
+
+        js_object_foreach( _element, &__binary_count_object_foreach, &count );
+    }
+
+    return count;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_count_array_foreach( js_size_t _index, const js_element_t * _value, void * _ud )
+{
+    JS_UNUSED( _index );
+
+    js_size_t * count = (js_size_t *)_ud;
+
+    *count += __binary_count_element( _value );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_count_object_foreach( js_size_t _index, const js_element_t * _key, const js_element_t * _value, void * _ud )
+{
+    JS_UNUSED( _index );
+    JS_UNUSED( _key );
+
+    js_size_t * count = (js_size_t *)_ud;
+
+    *count += __binary_count_element( _value );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_measure_document( js_binary_writer_t * _writer, const js_element_t * _element )
+{
+    js_size_t count = __binary_count_element( _element );
+
+    js_allocator_t * allocator = &_writer->ctx->allocator;
+
+    js_binary_extent_t * extents = (js_binary_extent_t *)allocator->alloc( sizeof( js_binary_extent_t ) * count, allocator->ud );
+
+    if( extents == JS_NULLPTR )
+    {
+        return JS_FAILURE;
+    }
+
+    _writer->extents = extents;
+    _writer->extents_size = 0;
+    _writer->extent = 0;
+
+    __binary_measure_element( _writer, _element );
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_integer( js_binary_writer_t * _writer, const js_element_t * _element )
+{
+    js_integer_t value = js_get_integer( _element );
+
+    if( __binary_is_compact( _writer->flags ) == JS_TRUE )
+    {
+        if( __binary_is_small_integer( value ) == JS_TRUE )
+        {
+            uint8_t type8 = (uint8_t)(js_binary_type_integer_small + (value - JS_BINARY_SMALL_INTEGER_MIN));
+            __binary_write( _writer, &type8, sizeof( uint8_t ) );
+        }
+        else
+        {
+            __binary_write_type( _writer, js_binary_type_integer_varint );
+
+            uint64_t zigzag = __binary_zigzag_encode( value );
+            __binary_write_varint( _writer, zigzag );
+        }
+    }
+    else if( value == 0 )
+    {
+        __binary_write_type( _writer, js_binary_type_integer_z );
+    }
+    else if( value == 1 )
+    {
+        __binary_write_type( _writer, js_binary_type_integer_1 );
+    }
+    else
+    {
+        __binary_write_type( _writer, js_binary_type_integer );
+        __binary_write( _writer, &value, sizeof( js_integer_t ) );
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_real( js_binary_writer_t * _writer, const js_element_t * _element )
+{
+    js_real_t value = js_get_real( _element );
+
+    if( value == (js_real_t)0.0 )
+    {
+        __binary_write_type( _writer, js_binary_type_real_z );
+    }
+    else if( value == (js_real_t)1.0 )
+    {
+        __binary_write_type( _writer, js_binary_type_real_1 );
+    }
+    else
+    {
+        __binary_write_type( _writer, js_binary_type_real );
+        __binary_write( _writer, &value, sizeof( js_real_t ) );
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_string( js_binary_writer_t * _writer, js_string_t _value )
+{
+    if( _value.size == 0 )
+    {
+        __binary_write_type( _writer, js_binary_type_string_z );
+
+        return;
+    }
+
+    const js_binary_string_t * entry = __binary_strings_lookup( _writer, _value );
+
+    if( entry != JS_NULLPTR )
+    {
+        __binary_write_type( _writer, js_binary_type_string_ref );
+        __binary_write_varint( _writer, entry->index );
+
+        return;
+    }
+
+    __binary_write_type( _writer, js_binary_type_string );
+
+    __binary_write_size( _writer, _value.size );
+    __binary_write( _writer, _value.value, _value.size );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_array_foreach( js_size_t _index, const js_element_t * _value, void * _ud )
+{
+    JS_UNUSED( _index );
+
+    js_binary_writer_t * writer = (js_binary_writer_t *)_ud;
+
+    __binary_write_element( writer, _value );
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_binary_table_t
+{
+    js_binary_writer_t * writer;
+    js_size_t offset;
+    js_size_t offset_size;
+    js_size_t extent;
+} js_binary_table_t;
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_offset( js_binary_writer_t * _writer, js_size_t _offset, js_size_t _offset_size )
+{
+    if( _offset_size == sizeof( uint32_t ) )
+    {
+        uint32_t offset32 = (uint32_t)_offset;
+        __binary_write( _writer, &offset32, sizeof( uint32_t ) );
+    }
+    else
+    {
+        uint64_t offset64 = (uint64_t)_offset;
+        __binary_write( _writer, &offset64, sizeof( uint64_t ) );
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_array_table_foreach( js_size_t _index, const js_element_t * _value, void * _ud )
+{
+    JS_UNUSED( _index );
+
+    js_binary_table_t * table = (js_binary_table_t *)_ud;
+
+    __binary_write_offset( table->writer, table->offset, table->offset_size );
+
+    table->offset += __binary_measure_stored( table->writer, _value, &table->extent );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_array( js_binary_writer_t * _writer, const js_element_t * _element )
+{
+    js_size_t size = js_array_size( _element );
+
+    if( size == 0 )
+    {
+        __binary_write_type( _writer, js_binary_type_array_z );
+
+        return;
+    }
+
+    if( __binary_is_skippable( _writer->flags ) == JS_FALSE )
+    {
+        __binary_write_type( _writer, js_binary_type_array );
+        __binary_write_size( _writer, size );
+
+        js_array_foreach( _element, &__binary_write_array_foreach, _writer );
+
+        return;
+    }
+
+    const js_binary_extent_t * extent = _writer->extents + _writer->extent++;
+
+    js_size_t offset_size = 0;
+
+    if( __binary_is_table( _writer->flags, size ) == JS_TRUE )
+    {
+        offset_size = __binary_table_offset_size( extent->values );
+    }
+
+    if( offset_size == 0 )
+    {
+        __binary_write_type( _writer, js_binary_type_array );
+    }
+    else if( offset_size == sizeof( uint32_t ) )
+    {
+        __binary_write_type( _writer, js_binary_type_array_table );
+    }
+    else
+    {
+        __binary_write_type( _writer, js_binary_type_array_table64 );
+    }
+
+    __binary_write_size( _writer, size );
+    __binary_write_size( _writer, size * offset_size + extent->values );
+
+    if( offset_size != 0 )
+    {
+        js_binary_table_t array_table;
+        array_table.writer = _writer;
+        array_table.offset = 0;
+        array_table.offset_size = offset_size;
+        array_table.extent = _writer->extent;
+
+        js_array_foreach( _element, &__binary_write_array_table_foreach, &array_table );
+    }
+
+    js_array_foreach( _element, &__binary_write_array_foreach, _writer );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_object_foreach( js_size_t _index, const js_element_t * _key, const js_element_t * _value, void * _ud )
+{
+    JS_UNUSED( _index );
+
+    js_binary_writer_t * writer = (js_binary_writer_t *)_ud;
+
+    js_string_t key;
+    js_get_string( _key, &key );
+
+    __binary_write_string( writer, key );
+
+    __binary_write_element( writer, _value );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_object_table_foreach( js_size_t _index, const js_element_t * _key, const js_element_t * _value, void * _ud )
+{
+    JS_UNUSED( _index );
+
+    js_binary_table_t * table = (js_binary_table_t *)_ud;
+
+    js_string_t key;
+    js_get_string( _key, &key );
+
+    uint32_t hash = js_strhash( key );
+
+    __binary_write_u32( table->writer, hash );
+    __binary_write_offset( table->writer, table->offset, table->offset_size );
+
+    table->offset += __binary_measure_string( table->writer, key );
+    table->offset += __binary_measure_stored( table->writer, _value, &table->extent );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_object( js_binary_writer_t * _writer, const js_element_t * _element )
+{
+    js_size_t root_size = js_object_size( _element );
+
+    if( root_size == 0 )
+    {
+        __binary_write_type( _writer, js_binary_type_dict_z );
+
+        return;
+    }
+
+    if( __binary_is_skippable( _writer->flags ) == JS_FALSE )
+    {
+        __binary_write_type( _writer, js_binary_type_dict );
+        __binary_write_size( _writer, root_size );
+
+        js_object_foreach( _element, &__binary_write_object_foreach, _writer );
+
+        return;
+    }
+
+    const js_binary_extent_t * extent = _writer->extents + _writer->extent++;
+
+    js_size_t offset_size = 0;
+
+    if( __binary_is_table( _writer->flags, root_size ) == JS_TRUE )
+    {
+        offset_size = __binary_table_offset_size( extent->values );
+    }
+
+    if( offset_size == 0 )
+    {
+        __binary_write_type( _writer, js_binary_type_dict );
+    }
+    else if( offset_size == sizeof( uint32_t ) )
+    {
+        __binary_write_type( _writer, js_binary_type_dict_table );
+    }
+    else
+    {
+        __binary_write_type( _writer, js_binary_type_dict_table64 );
+    }
+
+    __binary_write_size( _writer, root_size );
+
+    js_size_t table_size = offset_size == 0 ? 0 : root_size * (sizeof( uint32_t ) + offset_size);
+
+    __binary_write_size( _writer, table_size + extent->values );
+
+    if( offset_size != 0 )
+    {
+        js_binary_table_t object_table;
+        object_table.writer = _writer;
+        object_table.offset = 0;
+        object_table.offset_size = offset_size;
+        object_table.extent = _writer->extent;
+
+        js_object_foreach( _element, &__binary_write_object_table_foreach, &object_table );
+    }
+
+    js_object_foreach( _element, &__binary_write_object_foreach, _writer );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_element( js_binary_writer_t * _writer, const js_element_t * _element )
+{
+    js_type_t type = js_type( _element );
+
+    switch( type )
+    {
+    case js_type_null:
+        {
+            __binary_write_type( _writer, js_binary_type_null );
+        }break;
+    case js_type_false:
+        {
+            __binary_write_type( _writer, js_binary_type_false );
+        }break;
+    case js_type_true:
+        {
+            __binary_write_type( _writer, js_binary_type_true );
+        }break;
+    case js_type_integer:
+        {
+            __binary_write_integer( _writer, _element );            
+        }break;
+    case js_type_real:
+        {
+            __binary_write_real( _writer, _element );
+        }break;
+    case js_type_string:
+        {
+            js_string_t str;
+            js_get_string( _element, &str );
+
+            __binary_write_string( _writer, str );
+        }break;
+    case js_type_array:
+        {
+            __binary_write_array( _writer, _element );
+        }break;
+    case js_type_object:
+        {
+            __binary_write_object( _writer, _element );
+        }break;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+void js_make_binary_ex_ctx_default( js_allocator_t _allocator, js_binary_write_fun_t _fun, void * _ud, js_binary_flags_t _flags, js_binary_ex_ctx_t * const _ctx )
+{
+    _ctx->write = _fun;
+    _ctx->ud = _ud;
+    _ctx->allocator = _allocator;
+    _ctx->flags = _flags;
+    _ctx->stage = JS_NULLPTR;
+    _ctx->stage_capacity = 0;
+    _ctx->buffer = JS_NULLPTR;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_make_binary_ex_ctx_stage( js_allocator_t _allocator, js_binary_write_fun_t _fun, void * _ud, js_binary_flags_t _flags, void * _stage, js_size_t _capacity, js_binary_ex_ctx_t * const _ctx )
+{
+    _ctx->write = _fun;
+    _ctx->ud = _ud;
+    _ctx->allocator = _allocator;
+    _ctx->flags = _flags;
+    _ctx->stage = _stage;
+    _ctx->stage_capacity = _capacity;
+    _ctx->buffer = JS_NULLPTR;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_make_binary_ex_ctx_buffer( js_allocator_t _allocator, js_buffer_t * _buffer, js_binary_flags_t _flags, js_binary_ex_ctx_t * const _ctx )
+{
+    _ctx->write = JS_NULLPTR;
+    _ctx->ud = JS_NULLPTR;
+    _ctx->allocator = _allocator;
+    _ctx->flags = _flags;
+    _ctx->stage = JS_NULLPTR;
+    _ctx->stage_capacity = 0;
+    _ctx->buffer = _buffer;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_collect_element( js_binary_writer_t * _writer, const js_element_t * _element );
+//////////////////////////////////////////////////////////////////////////
+static void __binary_collect_array_foreach( js_size_t _index, const js_element_t * _value, void * _ud )
+{
+    JS_UNUSED( _index );
+
+    js_binary_writer_t * writer = (js_binary_writer_t *)_ud;
+
+    __binary_collect_element( writer, _value );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_collect_object_foreach( js_size_t _index, const js_element_t * _key, const js_element_t * _value, void * _ud )
+{
+    JS_UNUSED( _index );
+
+    js_binary_writer_t * writer = (js_binary_writer_t *)_ud;
+
+    js_string_t key;
+    js_get_string( _key, &key );
+
+    __binary_strings_add( writer->strings, key );
+
+    __binary_collect_element( writer, _value );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_collect_element( js_binary_writer_t * _writer, const js_element_t * _element )
+{
+    js_type_t type = js_type( _element );
+
+    switch( type )
+    {
+    case js_type_string:
+        {
+            if( (_writer->flags & js_binary_flag_string_values) == 0 )
+            {
+                break;
+            }
+
+            js_string_t str;
+            js_get_string( _element, &str );
+
+            if( str.size > JS_BINARY_STRING_VALUE_MAX_SIZE )
+            {
+                break;
+            }
+
+            __binary_strings_add( _writer->strings, str );
+        }break;
+    case js_type_array:
+        {
+            js_array_foreach( _element, &__binary_collect_array_foreach, _writer );
+        }break;
+    case js_type_object:
+        {
+            js_object_foreach( _element, &__binary_collect_object_foreach, _writer );
+        }break;
+    default:
+        break;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_strings( js_binary_writer_t * _writer )
+{
+    js_binary_strings_t * strings = _writer->strings;
+
+    js_size_t content = strings->count * sizeof( uint32_t );
+
+    for( js_size_t index = 0; index != JS_BINARY_STRING_TABLE_SIZE; ++index )
+    {
+        const js_binary_string_t * entry = strings->entries + index;
+
+        if( entry->count < 2 )
+        {
+            continue;
+        }
+
+        content += __binary_measure_size( _writer->flags, entry->value.size ) + entry->value.size;
+    }
+
+    __binary_write_size( _writer, strings->count );
+    __binary_write_size( _writer, content );
+
+    js_size_t offset = 0;
+
+    for( js_size_t index = 0; index != JS_BINARY_STRING_TABLE_SIZE; ++index )
+    {
+        const js_binary_string_t * entry = strings->entries + index;
+
+        if( entry->count < 2 )
+        {
+            continue;
+        }
+
+        __binary_write_u32( _writer, (uint32_t)offset );
+
+        offset += __binary_measure_size( _writer->flags, entry->value.size ) + entry->value.size;
+    }
+
+    for( js_size_t index = 0; index != JS_BINARY_STRING_TABLE_SIZE; ++index )
+    {
+        const js_binary_string_t * entry = strings->entries + index;
+
+        if( entry->count < 2 )
+        {
+            continue;
+        }
+
+        __binary_write_size( _writer, entry->value.size );
+        __binary_write( _writer, entry->value.value, entry->value.size );
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_document( js_binary_writer_t * _writer, const js_element_t * _element )
+{
+    js_size_t root_size = js_object_size( _element );
+
+    if( root_size != 0 && __binary_is_skippable( _writer->flags ) == JS_TRUE )
+    {
+        if( __binary_measure_document( _writer, _element ) == JS_FAILURE )
+        {
+            _writer->failed = JS_TRUE;
+
+            return;
+        }
+    }
+
+    if( _writer->flags != js_binary_flag_none )
+    {
+        __binary_write_type( _writer, js_binary_type_header );
+
+        __binary_write_byte( _writer, (uint8_t)_writer->flags );
+    }
+
+    if( _writer->strings != JS_NULLPTR )
+    {
+        __binary_write_strings( _writer );
+    }
+
+    if( root_size == 0 )
+    {
+        return;
+    }
+
+    __binary_write_object( _writer, _element );
+
+    if( _writer->extents != JS_NULLPTR )
+    {
+        js_allocator_t * allocator = &_writer->ctx->allocator;
+
+        allocator->free( _writer->extents, allocator->ud );
+
+        _writer->extents = JS_NULLPTR;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write_document_strings( js_binary_writer_t * _writer, const js_element_t * _element )
+{
+    js_binary_strings_t strings;
+
+    for( js_size_t index = 0; index != JS_BINARY_STRING_TABLE_SIZE; ++index )
+    {
+        js_binary_string_t * entry = strings.entries + index;
+
+        entry->value.value = JS_NULLPTR;
+        entry->value.size = 0;
+        entry->count = 0;
+    }
+
+    strings.size = 0;
+    strings.count = 0;
+
+    _writer->strings = &strings;
+
+    js_object_foreach( _element, &__binary_collect_object_foreach, _writer );
+
+    for( js_size_t index = 0; index != JS_BINARY_STRING_TABLE_SIZE; ++index )
+    {
+        js_binary_string_t * entry = strings.entries + index;
+
+        if( entry->count < 2 )
+        {
+            continue;
+        }
+
+        entry->index = (uint32_t)strings.count++;
+    }
+
+    __binary_write_document( _writer, _element );
+
+    _writer->strings = JS_NULLPTR;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_binary_ex( const js_element_t * _element, js_binary_ex_ctx_t * _ctx )
+{
+    uint8_t stage[JS_BINARY_STAGE_SIZE];
+
+    js_binary_writer_t writer;
+    writer.ctx = _ctx;
+    writer.flags = _ctx->flags;
+    writer.strings = JS_NULLPTR;
+    writer.extents = JS_NULLPTR;
+    writer.extents_size = 0;
+    writer.extent = 0;
+    writer.overflow = JS_FALSE;
+    writer.failed = JS_FALSE;
+
+    if( _ctx->buffer != JS_NULLPTR )
+    {
+        writer.stage_begin = _ctx->buffer->memory;
+        writer.stage_end = _ctx->buffer->end;
+    }
+    else if( _ctx->stage != JS_NULLPTR )
+    {
+        writer.stage_begin = (uint8_t *)_ctx->stage;
+        writer.stage_end = (uint8_t *)_ctx->stage + _ctx->stage_capacity;
+    }
+    else
+    {
+        writer.stage_begin = stage;
+        writer.stage_end = stage + JS_BINARY_STAGE_SIZE;
+    }
+
+    writer.stage = writer.stage_begin;
+
+    if( __binary_is_strings( writer.flags ) == JS_TRUE )
+    {
+        __binary_write_document_strings( &writer, _element );
+    }
+    else
+    {
+        __binary_write_document( &writer, _element );
+    }
+
+    __binary_flush( &writer );
+
+    if( writer.overflow == JS_TRUE || writer.failed == JS_TRUE )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_binary( const js_element_t * _element, js_binary_ctx_t * _ctx )
+{
+    js_allocator_t allocator;
+    allocator.alloc = JS_NULLPTR;
+    allocator.free = JS_NULLPTR;
+    allocator.ud = JS_NULLPTR;
+
+    js_binary_ex_ctx_t ctx;
+    js_make_binary_ex_ctx_default( allocator, _ctx->write, _ctx->ud, js_binary_flag_none, &ctx );
+
+    js_binary_ex( _element, &ctx );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_read_bytes( const uint8_t ** _data, const uint8_t * _end, void * const _value, js_size_t _size )
+{
+    if( (js_size_t)(_end - *_data) < _size )
+    {
+        return JS_FAILURE;
+    }
+
+    js_memcpy( (char *)_value, (const char *)*_data, _size );
+
+    *_data += _size;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_read_type( const js_binary_view_t * _stream, const uint8_t ** _data, js_binary_type_e * const _type )
+{
+    if( *_data == _stream->end )
+    {
+        return JS_FAILURE;
+    }
+
+    *_type = (js_binary_type_e)**_data;
+
+    ++(*_data);
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_read_varint( const js_binary_view_t * _stream, const uint8_t ** _data, uint64_t * const _value )
+{
+    const uint8_t * data = *_data;
+
+    uint64_t value = 0;
+
+    for( uint32_t shift = 0; shift != JS_BINARY_VARINT_MAX_SIZE * 7; shift += 7 )
+    {
+        if( data == _stream->end )
+        {
+            return JS_FAILURE;
+        }
+
+        uint8_t byte = *data++;
+
+        value |= (uint64_t)(byte & 0x7F) << shift;
+
+        if( (byte & 0x80) == 0 )
+        {
+            *_value = value;
+            *_data = data;
+
+            return JS_SUCCESSFUL;
+        }
+    }
+
+    return JS_FAILURE;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_read_size( const js_binary_view_t * _stream, const uint8_t ** _data, js_size_t * const _size )
+{
+    if( __binary_is_compact( _stream->flags ) == JS_TRUE )
+    {
+        uint64_t value;
+        if( __binary_read_varint( _stream, _data, &value ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        if( (uint64_t)(js_size_t)value != value )
+        {
+            return JS_FAILURE;
+        }
+
+        *_size = (js_size_t)value;
+
+        return JS_SUCCESSFUL;
+    }
+
+    uint8_t size8;
+    if( __binary_read_bytes( _data, _stream->end, &size8, sizeof( uint8_t ) ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( size8 < 255 )
+    {
+        *_size = (js_size_t)size8;
+
+        return JS_SUCCESSFUL;
+    }
+
+    uint32_t size32;
+    if( __binary_read_bytes( _data, _stream->end, &size32, sizeof( uint32_t ) ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( size32 != UINT32_MAX )
+    {
+        *_size = (js_size_t)size32;
+
+        return JS_SUCCESSFUL;
+    }
+
+    uint64_t size64;
+    if( __binary_read_bytes( _data, _stream->end, &size64, sizeof( uint64_t ) ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( (uint64_t)(js_size_t)size64 != size64 )
+    {
+        return JS_FAILURE;
+    }
+
+    *_size = (js_size_t)size64;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __binary_is_small_integer_type( js_binary_type_e _type )
+{
+    if( (uint32_t)_type >= (uint32_t)js_binary_type_integer_small )
+    {
+        return JS_TRUE;
+    }
+
+    return JS_FALSE;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_integer_t __binary_small_integer_value( js_binary_type_e _type )
+{
+    js_integer_t value = (js_integer_t)((uint32_t)_type - (uint32_t)js_binary_type_integer_small) + JS_BINARY_SMALL_INTEGER_MIN;
+
+    return value;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_read_integer_varint( const js_binary_view_t * _stream, const uint8_t ** _data, js_integer_t * const _value )
+{
+    uint64_t zigzag;
+    if( __binary_read_varint( _stream, _data, &zigzag ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    *_value = __binary_zigzag_decode( zigzag );
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_read_string_ref( const js_binary_view_t * _stream, const uint8_t ** _data, js_string_t * const _value )
+{
+    uint64_t index;
+    if( __binary_read_varint( _stream, _data, &index ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( index >= _stream->strings_count )
+    {
+        return JS_FAILURE;
+    }
+
+    uint32_t offset;
+    js_memcpy( (char *)&offset, (const char *)_stream->strings + index * sizeof( uint32_t ), sizeof( uint32_t ) );
+
+    const uint8_t * data = _stream->strings + _stream->strings_count * sizeof( uint32_t );
+
+    if( (js_size_t)(_stream->end - data) <= offset )
+    {
+        return JS_FAILURE;
+    }
+
+    data += offset;
+
+    js_size_t size;
+    if( __binary_read_size( _stream, &data, &size ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( (js_size_t)(_stream->end - data) < size )
+    {
+        return JS_FAILURE;
+    }
+
+    _value->value = (const char *)data;
+    _value->size = size;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_read_string_value( const js_binary_view_t * _stream, const uint8_t ** _data, js_binary_type_e _type, js_string_t * const _value )
+{
+    if( _type == js_binary_type_string_ref )
+    {
+        js_result_t result = __binary_read_string_ref( _stream, _data, _value );
+
+        return result;
+    }
+
+    if( _type == js_binary_type_string_z )
+    {
+        _value->value = (const char *)*_data;
+        _value->size = 0;
+
+        return JS_SUCCESSFUL;
+    }
+
+    if( _type != js_binary_type_string )
+    {
+        return JS_FAILURE;
+    }
+
+    js_size_t size;
+    if( __binary_read_size( _stream, _data, &size ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( (js_size_t)(_stream->end - *_data) < size )
+    {
+        return JS_FAILURE;
+    }
+
+    _value->value = (const char *)*_data;
+    _value->size = size;
+
+    *_data += size;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_read_string( const js_binary_view_t * _stream, const uint8_t ** _data, js_string_t * const _value )
+{
+    js_binary_type_e type;
+    if( __binary_read_type( _stream, _data, &type ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    js_result_t result = __binary_read_string_value( _stream, _data, type, _value );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_binary_container_t
+{
+    js_size_t size;
+    const uint8_t * table;
+    js_size_t table_hash;
+    js_size_t table_offset;
+    const uint8_t * values;
+    const uint8_t * end;
+} js_binary_container_t;
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_read_container( const js_binary_view_t * _stream, const uint8_t ** _data, js_binary_type_e _type, js_binary_container_t * const _container )
+{
+    _container->size = 0;
+    _container->table = JS_NULLPTR;
+    _container->table_hash = 0;
+    _container->table_offset = 0;
+    _container->values = *_data;
+    _container->end = JS_NULLPTR;
+
+    switch( _type )
+    {
+    case js_binary_type_array_z:
+    case js_binary_type_dict_z:
+        {
+            _container->end = *_data;
+
+            return JS_SUCCESSFUL;
+        }break;
+    case js_binary_type_array:
+    case js_binary_type_dict:
+        {
+        }break;
+    case js_binary_type_array_table:
+        {
+            _container->table_offset = sizeof( uint32_t );
+        }break;
+    case js_binary_type_array_table64:
+        {
+            _container->table_offset = sizeof( uint64_t );
+        }break;
+    case js_binary_type_dict_table:
+        {
+            _container->table_hash = sizeof( uint32_t );
+            _container->table_offset = sizeof( uint32_t );
+        }break;
+    case js_binary_type_dict_table64:
+        {
+            _container->table_hash = sizeof( uint32_t );
+            _container->table_offset = sizeof( uint64_t );
+        }break;
+    default:
+        {
+            return JS_FAILURE;
+        }break;
+    }
+
+    if( __binary_read_size( _stream, _data, &_container->size ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( __binary_is_skippable( _stream->flags ) == JS_TRUE )
+    {
+        js_size_t content;
+        if( __binary_read_size( _stream, _data, &content ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        if( (js_size_t)(_stream->end - *_data) < content )
+        {
+            return JS_FAILURE;
+        }
+
+        _container->end = *_data + content;
+    }
+    else if( _container->table_offset != 0 )
+    {
+        return JS_FAILURE;
+    }
+
+    if( _container->table_offset != 0 )
+    {
+        js_size_t table_entry = _container->table_hash + _container->table_offset;
+
+        if( (js_size_t)(_container->end - *_data) / table_entry < _container->size )
+        {
+            return JS_FAILURE;
+        }
+
+        _container->table = *_data;
+
+        *_data += _container->size * table_entry;
+    }
+
+    _container->values = *_data;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_skip_element( const js_binary_view_t * _stream, const uint8_t ** _data )
+{
+    js_binary_type_e type;
+    if( __binary_read_type( _stream, _data, &type ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    switch( type )
+    {
+    case js_binary_type_null:
+    case js_binary_type_false:
+    case js_binary_type_true:
+    case js_binary_type_integer_z:
+    case js_binary_type_integer_1:
+    case js_binary_type_real_z:
+    case js_binary_type_real_1:
+    case js_binary_type_string_z:
+    case js_binary_type_array_z:
+    case js_binary_type_dict_z:
+        {
+            return JS_SUCCESSFUL;
+        }break;
+    case js_binary_type_integer:
+        {
+            if( (js_size_t)(_stream->end - *_data) < sizeof( js_integer_t ) )
+            {
+                return JS_FAILURE;
+            }
+
+            *_data += sizeof( js_integer_t );
+        }break;
+    case js_binary_type_integer_varint:
+        {
+            js_integer_t value;
+            if( __binary_read_integer_varint( _stream, _data, &value ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+        }break;
+    case js_binary_type_real:
+        {
+            if( (js_size_t)(_stream->end - *_data) < sizeof( js_real_t ) )
+            {
+                return JS_FAILURE;
+            }
+
+            *_data += sizeof( js_real_t );
+        }break;
+    case js_binary_type_string:
+    case js_binary_type_string_ref:
+        {
+            js_string_t str;
+            if( __binary_read_string_value( _stream, _data, type, &str ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+        }break;
+    case js_binary_type_array:
+    case js_binary_type_array_table:
+    case js_binary_type_array_table64:
+        {
+            js_binary_container_t container;
+            if( __binary_read_container( _stream, _data, type, &container ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            if( container.end != JS_NULLPTR )
+            {
+                *_data = container.end;
+
+                return JS_SUCCESSFUL;
+            }
+
+            for( js_size_t index = 0; index != container.size; ++index )
+            {
+                if( __binary_skip_element( _stream, _data ) == JS_FAILURE )
+                {
+                    return JS_FAILURE;
+                }
+            }
+        }break;
+    case js_binary_type_dict:
+    case js_binary_type_dict_table:
+    case js_binary_type_dict_table64:
+        {
+            js_binary_container_t container;
+            if( __binary_read_container( _stream, _data, type, &container ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            if( container.end != JS_NULLPTR )
+            {
+                *_data = container.end;
+
+                return JS_SUCCESSFUL;
+            }
+
+            for( js_size_t index = 0; index != container.size; ++index )
+            {
+                js_string_t key;
+                if( __binary_read_string( _stream, _data, &key ) == JS_FAILURE )
+                {
+                    return JS_FAILURE;
+                }
+
+                if( __binary_skip_element( _stream, _data ) == JS_FAILURE )
+                {
+                    return JS_FAILURE;
+                }
+            }
+        }break;
+    default:
+        {
+            if( __binary_is_small_integer_type( type ) == JS_FALSE )
+            {
+                return JS_FAILURE;
+            }
+        }break;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_read_root( const void * _data, js_size_t _size, js_binary_view_t * const _stream )
+{
+    const uint8_t * data = (const uint8_t *)_data;
+    const uint8_t * data_end = data + _size;
+
+    _stream->data = data;
+    _stream->end = data_end;
+    _stream->strings = JS_NULLPTR;
+    _stream->strings_count = 0;
+    _stream->flags = js_binary_flag_none;
+
+    if( data != data_end && *data == js_binary_type_header )
+    {
+        ++data;
+
+        uint8_t flags8;
+        if( __binary_read_bytes( &data, data_end, &flags8, sizeof( uint8_t ) ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        _stream->data = data;
+        _stream->flags = (js_binary_flags_t)flags8;
+    }
+
+    if( __binary_is_strings( _stream->flags ) == JS_FALSE )
+    {
+        return JS_SUCCESSFUL;
+    }
+
+    js_size_t strings_count;
+    if( __binary_read_size( _stream, &data, &strings_count ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    js_size_t strings_content;
+    if( __binary_read_size( _stream, &data, &strings_content ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( (js_size_t)(data_end - data) < strings_content )
+    {
+        return JS_FAILURE;
+    }
+
+    if( strings_content / sizeof( uint32_t ) < strings_count )
+    {
+        return JS_FAILURE;
+    }
+
+    _stream->strings = data;
+    _stream->strings_count = strings_count;
+    _stream->data = data + strings_content;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_null( js_element_t * _document, js_element_t * _parent, const js_string_t * _key )
+{
+    if( _key == JS_NULLPTR )
+    {
+        js_result_t result = js_array_push_null( _document, _parent );
+
+        return result;
+    }
+
+    js_result_t result = js_object_add_field_null( _document, _parent, *_key );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_boolean( js_element_t * _document, js_element_t * _parent, const js_string_t * _key, js_bool_t _value )
+{
+    if( _key == JS_NULLPTR )
+    {
+        js_result_t result = js_array_push_boolean( _document, _parent, _value );
+
+        return result;
+    }
+
+    js_result_t result = js_object_add_field_boolean( _document, _parent, *_key, _value );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_integer( js_element_t * _document, js_element_t * _parent, const js_string_t * _key, js_integer_t _value )
+{
+    if( _key == JS_NULLPTR )
+    {
+        js_result_t result = js_array_push_integer( _document, _parent, _value );
+
+        return result;
+    }
+
+    js_result_t result = js_object_add_field_integer( _document, _parent, *_key, _value );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_real( js_element_t * _document, js_element_t * _parent, const js_string_t * _key, js_real_t _value )
+{
+    if( _key == JS_NULLPTR )
+    {
+        js_result_t result = js_array_push_real( _document, _parent, _value );
+
+        return result;
+    }
+
+    js_result_t result = js_object_add_field_real( _document, _parent, *_key, _value );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_string( js_element_t * _document, js_element_t * _parent, const js_string_t * _key, js_string_t _value )
+{
+    if( _key == JS_NULLPTR )
+    {
+        js_result_t result = js_array_push_stringn( _document, _parent, _value );
+
+        return result;
+    }
+
+    js_result_t result = js_object_add_field_stringn( _document, _parent, *_key, _value );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_array( js_element_t * _document, js_element_t * _parent, const js_string_t * _key, js_element_t ** _array )
+{
+    if( _key == JS_NULLPTR )
+    {
+        js_result_t result = js_array_push_array( _document, _parent, _array );
+
+        return result;
+    }
+
+    js_result_t result = js_object_add_field_array( _document, _parent, *_key, _array );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_object( js_element_t * _document, js_element_t * _parent, const js_string_t * _key, js_element_t ** _object )
+{
+    if( _key == JS_NULLPTR )
+    {
+        js_result_t result = js_array_push_object( _document, _parent, _object );
+
+        return result;
+    }
+
+    js_result_t result = js_object_add_field_object( _document, _parent, *_key, _object );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_array_values( js_element_t * _document, js_element_t * _array, const js_binary_view_t * _stream, const uint8_t ** _data, js_size_t _size );
+static js_result_t __binary_load_object_values( js_element_t * _document, js_element_t * _object, const js_binary_view_t * _stream, const uint8_t ** _data, js_size_t _size );
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_element( js_element_t * _document, js_element_t * _parent, const js_string_t * _key, const js_binary_view_t * _stream, const uint8_t ** _data )
+{
+    js_binary_type_e type;
+    if( __binary_read_type( _stream, _data, &type ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    switch( type )
+    {
+    case js_binary_type_null:
+        {
+            js_result_t result = __binary_load_null( _document, _parent, _key );
+
+            return result;
+        }break;
+    case js_binary_type_false:
+        {
+            js_result_t result = __binary_load_boolean( _document, _parent, _key, JS_FALSE );
+
+            return result;
+        }break;
+    case js_binary_type_true:
+        {
+            js_result_t result = __binary_load_boolean( _document, _parent, _key, JS_TRUE );
+
+            return result;
+        }break;
+    case js_binary_type_integer_z:
+        {
+            js_result_t result = __binary_load_integer( _document, _parent, _key, 0 );
+
+            return result;
+        }break;
+    case js_binary_type_integer_1:
+        {
+            js_result_t result = __binary_load_integer( _document, _parent, _key, 1 );
+
+            return result;
+        }break;
+    case js_binary_type_integer:
+        {
+            js_integer_t value;
+            if( __binary_read_bytes( _data, _stream->end, &value, sizeof( js_integer_t ) ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            js_result_t result = __binary_load_integer( _document, _parent, _key, value );
+
+            return result;
+        }break;
+    case js_binary_type_integer_varint:
+        {
+            js_integer_t value;
+            if( __binary_read_integer_varint( _stream, _data, &value ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            js_result_t result = __binary_load_integer( _document, _parent, _key, value );
+
+            return result;
+        }break;
+    case js_binary_type_real_z:
+        {
+            js_result_t result = __binary_load_real( _document, _parent, _key, (js_real_t)0.0 );
+
+            return result;
+        }break;
+    case js_binary_type_real_1:
+        {
+            js_result_t result = __binary_load_real( _document, _parent, _key, (js_real_t)1.0 );
+
+            return result;
+        }break;
+    case js_binary_type_real:
+        {
+            js_real_t value;
+            if( __binary_read_bytes( _data, _stream->end, &value, sizeof( js_real_t ) ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            js_result_t result = __binary_load_real( _document, _parent, _key, value );
+
+            return result;
+        }break;
+    case js_binary_type_string_z:
+    case js_binary_type_string:
+    case js_binary_type_string_ref:
+        {
+            js_string_t value;
+            if( __binary_read_string_value( _stream, _data, type, &value ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            js_result_t result = __binary_load_string( _document, _parent, _key, value );
+
+            return result;
+        }break;
+    case js_binary_type_array_z:
+    case js_binary_type_array:
+    case js_binary_type_array_table:
+    case js_binary_type_array_table64:
+        {
+            js_binary_container_t container;
+            if( __binary_read_container( _stream, _data, type, &container ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            js_element_t * array;
+            if( __binary_load_array( _document, _parent, _key, &array ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            js_result_t result = __binary_load_array_values( _document, array, _stream, _data, container.size );
+
+            return result;
+        }break;
+    case js_binary_type_dict_z:
+    case js_binary_type_dict:
+    case js_binary_type_dict_table:
+    case js_binary_type_dict_table64:
+        {
+            js_binary_container_t container;
+            if( __binary_read_container( _stream, _data, type, &container ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            js_element_t * object;
+            if( __binary_load_object( _document, _parent, _key, &object ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+
+            js_result_t result = __binary_load_object_values( _document, object, _stream, _data, container.size );
+
+            return result;
+        }break;
+    default:
+        {
+            if( __binary_is_small_integer_type( type ) == JS_TRUE )
+            {
+                js_integer_t value = __binary_small_integer_value( type );
+
+                js_result_t result = __binary_load_integer( _document, _parent, _key, value );
+
+                return result;
+            }
+        }break;
+    }
+
+    return JS_FAILURE;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_array_values( js_element_t * _document, js_element_t * _array, const js_binary_view_t * _stream, const uint8_t ** _data, js_size_t _size )
+{
+    for( js_size_t index = 0; index != _size; ++index )
+    {
+        if( __binary_load_element( _document, _array, JS_NULLPTR, _stream, _data ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_load_object_values( js_element_t * _document, js_element_t * _object, const js_binary_view_t * _stream, const uint8_t ** _data, js_size_t _size )
+{
+    for( js_size_t index = 0; index != _size; ++index )
+    {
+        js_string_t key;
+        if( __binary_read_string( _stream, _data, &key ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        if( __binary_load_element( _document, _object, &key, _stream, _data ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_binary_load( js_allocator_t _allocator, js_flags_t _flags, const void * _data, js_size_t _size, js_element_t ** _document )
+{
+    js_binary_view_t stream;
+    if( __binary_read_root( _data, _size, &stream ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    js_element_t * document;
+    if( js_create( _allocator, _flags, &document ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    const uint8_t * data = stream.data;
+
+    if( data != stream.end )
+    {
+        js_binary_type_e type;
+        if( __binary_read_type( &stream, &data, &type ) == JS_FAILURE || (type != js_binary_type_dict && type != js_binary_type_dict_table && type != js_binary_type_dict_table64) )
+        {
+            js_free( document );
+
+            return JS_FAILURE;
+        }
+
+        js_binary_container_t container;
+        if( __binary_read_container( &stream, &data, type, &container ) == JS_FAILURE )
+        {
+            js_free( document );
+
+            return JS_FAILURE;
+        }
+
+        if( __binary_load_object_values( document, document, &stream, &data, container.size ) == JS_FAILURE )
+        {
+            js_free( document );
+
+            return JS_FAILURE;
+        }
+    }
+
+    *_document = document;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static const uint8_t __binary_view_empty_root = js_binary_type_dict_z;
+//////////////////////////////////////////////////////////////////////////
+static js_binary_type_e __binary_view_type( const js_binary_view_t * _view )
+{
+    js_binary_type_e type = (js_binary_type_e)*_view->data;
+
+    return type;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __binary_view_make( const js_binary_view_t * _view, const uint8_t * _data, js_binary_view_t * const _value )
+{
+    *_value = *_view;
+
+    _value->data = _data;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_binary_view( const void * _data, js_size_t _size, js_binary_view_t * const _view )
+{
+    if( __binary_read_root( _data, _size, _view ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( _view->data == _view->end )
+    {
+        _view->data = &__binary_view_empty_root;
+        _view->end = &__binary_view_empty_root + 1;
+
+        return JS_SUCCESSFUL;
+    }
+
+    js_binary_type_e type = __binary_view_type( _view );
+
+    if( type != js_binary_type_dict && type != js_binary_type_dict_table && type != js_binary_type_dict_table64 )
+    {
+        return JS_FAILURE;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_type_t js_binary_view_type( const js_binary_view_t * _view )
+{
+    js_binary_type_e type = __binary_view_type( _view );
+
+    switch( type )
+    {
+    case js_binary_type_null:
+        return js_type_null;
+    case js_binary_type_false:
+        return js_type_false;
+    case js_binary_type_true:
+        return js_type_true;
+    case js_binary_type_integer_z:
+    case js_binary_type_integer_1:
+    case js_binary_type_integer:
+    case js_binary_type_integer_varint:
+        return js_type_integer;
+    case js_binary_type_real_z:
+    case js_binary_type_real_1:
+    case js_binary_type_real:
+        return js_type_real;
+    case js_binary_type_string_z:
+    case js_binary_type_string:
+    case js_binary_type_string_ref:
+        return js_type_string;
+    case js_binary_type_array_z:
+    case js_binary_type_array:
+    case js_binary_type_array_table:
+    case js_binary_type_array_table64:
+        return js_type_array;
+    case js_binary_type_dict_z:
+    case js_binary_type_dict:
+    case js_binary_type_dict_table:
+    case js_binary_type_dict_table64:
+        return js_type_object;
+    default:
+        {
+            if( __binary_is_small_integer_type( type ) == JS_TRUE )
+            {
+                return js_type_integer;
+            }
+        }break;
+    }
+
+    return js_type_null;
+}
+//////////////////////////////////////////////////////////////////////////
+js_bool_t js_binary_view_get_boolean( const js_binary_view_t * _view )
+{
+    js_binary_type_e type = __binary_view_type( _view );
+
+    if( type == js_binary_type_true )
+    {
+        return JS_TRUE;
+    }
+
+    return JS_FALSE;
+}
+//////////////////////////////////////////////////////////////////////////
+js_integer_t js_binary_view_get_integer( const js_binary_view_t * _view )
+{
+    js_binary_type_e type = __binary_view_type( _view );
+
+    if( type == js_binary_type_integer_1 )
+    {
+        return 1;
+    }
+
+    if( __binary_is_small_integer_type( type ) == JS_TRUE )
+    {
+        js_integer_t value = __binary_small_integer_value( type );
+
+        return value;
+    }
+
+    const uint8_t * data = _view->data + 1;
+
+    if( type == js_binary_type_integer_varint )
+    {
+        js_integer_t value;
+        if( __binary_read_integer_varint( _view, &data, &value ) == JS_FAILURE )
+        {
+            return 0;
+        }
+
+        return value;
+    }
+
+    if( type != js_binary_type_integer )
+    {
+        return 0;
+    }
+
+    js_integer_t value;
+    if( __binary_read_bytes( &data, _view->end, &value, sizeof( js_integer_t ) ) == JS_FAILURE )
+    {
+        return 0;
+    }
+
+    return value;
+}
+//////////////////////////////////////////////////////////////////////////
+js_real_t js_binary_view_get_real( const js_binary_view_t * _view )
+{
+    js_binary_type_e type = __binary_view_type( _view );
+
+    if( type == js_binary_type_real_1 )
+    {
+        return (js_real_t)1.0;
+    }
+
+    if( type != js_binary_type_real )
+    {
+        return (js_real_t)0.0;
+    }
+
+    const uint8_t * data = _view->data + 1;
+
+    js_real_t value;
+    if( __binary_read_bytes( &data, _view->end, &value, sizeof( js_real_t ) ) == JS_FAILURE )
+    {
+        return (js_real_t)0.0;
+    }
+
+    return value;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_binary_view_get_string( const js_binary_view_t * _view, js_string_t * const _value )
+{
+    const uint8_t * data = _view->data;
+
+    if( __binary_read_string( _view, &data, _value ) == JS_FAILURE )
+    {
+        _value->value = JS_NULLPTR;
+        _value->size = 0;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_view_container( const js_binary_view_t * _view, js_type_t _type, js_binary_container_t * const _container )
+{
+    if( js_binary_view_type( _view ) != _type )
+    {
+        return JS_FAILURE;
+    }
+
+    const uint8_t * data = _view->data;
+
+    js_binary_type_e type;
+    if( __binary_read_type( _view, &data, &type ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    js_result_t result = __binary_read_container( _view, &data, type, _container );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static uint32_t __binary_view_table_hash( const js_binary_container_t * _container, js_size_t _index )
+{
+    js_size_t table_entry = _container->table_hash + _container->table_offset;
+
+    uint32_t hash;
+    js_memcpy( (char *)&hash, (const char *)_container->table + _index * table_entry, sizeof( uint32_t ) );
+
+    return hash;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_view_table_offset( const js_binary_container_t * _container, js_size_t _index, js_size_t * const _offset )
+{
+    js_size_t table_entry = _container->table_hash + _container->table_offset;
+
+    const char * entry = (const char *)_container->table + _index * table_entry + _container->table_hash;
+
+    uint64_t offset;
+
+    if( _container->table_offset == sizeof( uint32_t ) )
+    {
+        uint32_t offset32;
+        js_memcpy( (char *)&offset32, entry, sizeof( uint32_t ) );
+
+        offset = offset32;
+    }
+    else
+    {
+        js_memcpy( (char *)&offset, entry, sizeof( uint64_t ) );
+    }
+
+    if( (uint64_t)(_container->end - _container->values) <= offset )
+    {
+        return JS_FAILURE;
+    }
+
+    *_offset = (js_size_t)offset;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_size_t js_binary_view_array_size( const js_binary_view_t * _view )
+{
+    js_binary_container_t container;
+    if( __binary_view_container( _view, js_type_array, &container ) == JS_FAILURE )
+    {
+        return 0;
+    }
+
+    return container.size;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_binary_view_array_get( const js_binary_view_t * _view, js_size_t _index, js_binary_view_t * const _value )
+{
+    js_binary_container_t container;
+    if( __binary_view_container( _view, js_type_array, &container ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( _index >= container.size )
+    {
+        return JS_FAILURE;
+    }
+
+    const uint8_t * data = container.values;
+
+    if( container.table != JS_NULLPTR )
+    {
+        js_size_t offset;
+        if( __binary_view_table_offset( &container, _index, &offset ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        data += offset;
+    }
+    else
+    {
+        for( js_size_t index = 0; index != _index; ++index )
+        {
+            if( __binary_skip_element( _view, &data ) == JS_FAILURE )
+            {
+                return JS_FAILURE;
+            }
+        }
+    }
+
+    if( data == _view->end )
+    {
+        return JS_FAILURE;
+    }
+
+    __binary_view_make( _view, data, _value );
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_size_t js_binary_view_object_size( const js_binary_view_t * _view )
+{
+    js_binary_container_t container;
+    if( __binary_view_container( _view, js_type_object, &container ) == JS_FAILURE )
+    {
+        return 0;
+    }
+
+    return container.size;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_binary_view_object_get( const js_binary_view_t * _view, const char * _key, js_binary_view_t * const _value )
+{
+    js_size_t key_size = js_strlen( _key );
+
+    js_string_t key = {_key, key_size};
+
+    js_result_t result = js_binary_view_object_getn( _view, key, _value );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __binary_view_object_find_table( const js_binary_view_t * _view, const js_binary_container_t * _container, js_string_t _key, js_binary_view_t * const _value )
+{
+    uint32_t hash = js_strhash( _key );
+
+    for( js_size_t index = 0; index != _container->size; ++index )
+    {
+        uint32_t key_hash = __binary_view_table_hash( _container, index );
+
+        if( key_hash != hash )
+        {
+            continue;
+        }
+
+        js_size_t offset;
+        if( __binary_view_table_offset( _container, index, &offset ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        const uint8_t * data = _container->values + offset;
+
+        js_string_t key;
+        if( __binary_read_string( _view, &data, &key ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        if( js_strzcmp( _key, key ) == JS_FALSE )
+        {
+            continue;
+        }
+
+        if( data == _view->end )
+        {
+            return JS_FAILURE;
+        }
+
+        __binary_view_make( _view, data, _value );
+
+        return JS_SUCCESSFUL;
+    }
+
+    return JS_FAILURE;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_binary_view_object_getn( const js_binary_view_t * _view, js_string_t _key, js_binary_view_t * const _value )
+{
+    js_binary_container_t container;
+    if( __binary_view_container( _view, js_type_object, &container ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( container.table != JS_NULLPTR )
+    {
+        js_result_t result = __binary_view_object_find_table( _view, &container, _key, _value );
+
+        return result;
+    }
+
+    const uint8_t * data = container.values;
+
+    for( js_size_t index = 0; index != container.size; ++index )
+    {
+        js_string_t key;
+        if( __binary_read_string( _view, &data, &key ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        if( js_strzcmp( _key, key ) == JS_TRUE )
+        {
+            if( data == _view->end )
+            {
+                return JS_FAILURE;
+            }
+
+            __binary_view_make( _view, data, _value );
+
+            return JS_SUCCESSFUL;
+        }
+
+        if( __binary_skip_element( _view, &data ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+    }
+
+    return JS_FAILURE;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_binary_view_array_foreach( const js_binary_view_t * _view, js_binary_view_array_foreach_fun_t _foreach, void * _ud )
+{
+    js_binary_container_t container;
+    if( __binary_view_container( _view, js_type_array, &container ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    const uint8_t * data = container.values;
+
+    for( js_size_t index = 0; index != container.size; ++index )
+    {
+        js_binary_view_t value;
+        __binary_view_make( _view, data, &value );
+
+        if( __binary_skip_element( _view, &data ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        (*_foreach)(index, &value, _ud);
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_binary_view_object_foreach( const js_binary_view_t * _view, js_binary_view_object_foreach_fun_t _foreach, void * _ud )
+{
+    js_binary_container_t container;
+    if( __binary_view_container( _view, js_type_object, &container ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    const uint8_t * data = container.values;
+
+    for( js_size_t index = 0; index != container.size; ++index )
+    {
+        js_string_t key;
+        if( __binary_read_string( _view, &data, &key ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        js_binary_view_t value;
+        __binary_view_make( _view, data, &value );
+
+        if( __binary_skip_element( _view, &data ) == JS_FAILURE )
+        {
+            return JS_FAILURE;
+        }
+
+        (*_foreach)(index, key, &value, _ud);
+    }
 
-    js_object_foreach( _element, &__binary_write_object_foreach, _ctx );
+    return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
\ No newline at end of file
@@ -1,11 +1,18 @@
 #include "json/json_dump.h"
 
-#include "json/json.h"
-
 #include "json_string.h"
+#include "json_format.h"
 
 #define JS_DUMP( _ctx, _size ) ((char *)(*_ctx->buffer)(_size, _ctx->ud))
 
+#ifndef JS_DUMP_PARALLEL_SPLIT_SIZE
+#define JS_DUMP_PARALLEL_SPLIT_SIZE 1024
+#endif
+
+#ifndef JS_DUMP_PARALLEL_CHUNKS_PER_WORKER
+#define JS_DUMP_PARALLEL_CHUNKS_PER_WORKER 4
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 static void __js_dump_char( js_dump_ctx_t * _ctx, char _value )
 {
@@ -19,272 +26,373 @@ static void __js_dump_char( js_dump_ctx_t * _ctx, char _value )
     *(dst) = _value;
 }
 //////////////////////////////////////////////////////////////////////////
-static js_result_t __js_dump_string( js_dump_ctx_t * _ctx, js_string_t _value )
+static const char __js_escape_table[256] = {
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+//////////////////////////////////////////////////////////////////////////
+static const char __js_escape_hex[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+};
+//////////////////////////////////////////////////////////////////////////
+#if JS_SIMD_SSE2_ENABLE
+#   include <emmintrin.h>
+#   define JS_ESCAPE_CHUNK_SIZE 16
+#else
+#   define JS_ESCAPE_CHUNK_SIZE 8
+#endif
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_escape_chunk_clean( const char * _value )
 {
-    const char * value_str = _value.value;
-    js_size_t origin_size = _value.size;
-    js_size_t value_size = _value.size;
+#if JS_SIMD_SSE2_ENABLE
+    __m128i v = _mm_loadu_si128( (const __m128i *)_value );
 
-    for( const char * it_value = value_str,
-        *it_value_end = value_str + origin_size;
-        it_value != it_value_end; ++it_value )
-    {
-        char c = *it_value;
+    __m128i quote = _mm_cmpeq_epi8( v, _mm_set1_epi8( '\"' ) );
+    __m128i backslash = _mm_cmpeq_epi8( v, _mm_set1_epi8( '\\' ) );
+    __m128i control = _mm_cmpeq_epi8( _mm_max_epu8( v, _mm_set1_epi8( 0x1f ) ), _mm_set1_epi8( 0x1f ) );
 
-        switch( c )
-        {
-        case '\"':
-            ++value_size;
-            break;
-        case '\\':
-            ++value_size;
-            break;
-        default:
-            break;
-        }
+    __m128i escape = _mm_or_si128( _mm_or_si128( quote, backslash ), control );
+
+    if( _mm_movemask_epi8( escape ) != 0 )
+    {
+        return JS_FALSE;
     }
 
-    char * dst = JS_DUMP( _ctx, value_size );
+    return JS_TRUE;
+#else
+    uint64_t v = 0;
 
-    if( dst == JS_NULLPTR )
+    for( uint32_t index = 0; index != 8; ++index )
     {
-        return JS_FAILURE;
+        v |= (uint64_t)(uint8_t)_value[index] << (index * 8);
     }
 
-    char * it_buffer = dst;
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
 
-    for( const char * it_value = value_str,
-        *it_value_end = value_str + origin_size;
-        it_value != it_value_end; ++it_value )
-    {
-        char c = *it_value;
+    uint64_t quote = v ^ (ones * '\"');
+    uint64_t backslash = v ^ (ones * '\\');
 
-        switch( c )
-        {
-        case '\"':
-            *it_buffer++ = '\\';
-            *it_buffer++ = '\"';
-            break;
-        case '\\':
-            *it_buffer++ = '\\';
-            *it_buffer++ = '\\';
-            break;
-        default:
-            *it_buffer++ = c;
-        }
+    uint64_t escape = ((quote - ones) & ~quote)
+        | ((backslash - ones) & ~backslash)
+        | ((v - ones * 0x20) & ~v);
+
+    if( (escape & highs) != 0 )
+    {
+        return JS_FALSE;
     }
 
-    return JS_SUCCESSFUL;
+    return JS_TRUE;
+#endif
 }
 //////////////////////////////////////////////////////////////////////////
-static void __js_dump_string_internal( js_dump_ctx_t * _ctx, const char * _value, js_size_t _size )
+static void __js_escape_chunk_copy( char * _buffer, const char * _value )
 {
-    js_string_t str = {_value, _size};
-
-    __js_dump_string( _ctx, str );
+#if JS_SIMD_SSE2_ENABLE
+    __m128i v = _mm_loadu_si128( (const __m128i *)_value );
+    _mm_storeu_si128( (__m128i *)_buffer, v );
+#else
+    for( uint32_t index = 0; index != 8; ++index )
+    {
+        _buffer[index] = _value[index];
+    }
+#endif
 }
 //////////////////////////////////////////////////////////////////////////
-#define JS_DUMP_INTERNAL(data, value) __js_dump_string_internal(data, value, sizeof( value ) - 1)
-//////////////////////////////////////////////////////////////////////////
-#define JS_MAX_INTEGER_SYMBOLS 20
-//////////////////////////////////////////////////////////////////////////
-static void __js_dump_integer( js_dump_ctx_t * _ctx, js_integer_t _value )
+static js_size_t __js_escape_char_size( char _value )
 {
-    if( _value == 0 )
-    {
-        JS_DUMP_INTERNAL( _ctx, "0" );
+    char escape = __js_escape_table[(uint8_t)_value];
 
-        return;
+    if( escape == 0 )
+    {
+        return 1;
     }
-    else if( _value == 1 )
+    else if( escape == 'u' )
     {
-        JS_DUMP_INTERNAL( _ctx, "1" );
-
-        return;
+        return 6;
     }
 
-    char symbols[JS_MAX_INTEGER_SYMBOLS] = {'\0'};
+    return 2;
+}
+//////////////////////////////////////////////////////////////////////////
+static char * __js_escape_char( char * _buffer, char _value )
+{
+    char escape = __js_escape_table[(uint8_t)_value];
 
-    char * it = symbols + JS_MAX_INTEGER_SYMBOLS;
-    
-    if( _value == 0 )
+    if( escape == 0 )
+    {
+        *_buffer++ = _value;
+    }
+    else if( escape == 'u' )
     {
-        *--it = '0';
-    } 
-    else if( _value < 0 )
+        *_buffer++ = '\\';
+        *_buffer++ = 'u';
+        *_buffer++ = '0';
+        *_buffer++ = '0';
+        *_buffer++ = __js_escape_hex[((uint8_t)_value >> 4) & 0x0f];
+        *_buffer++ = __js_escape_hex[(uint8_t)_value & 0x0f];
+    }
+    else
     {
-        _value = -_value;
+        *_buffer++ = '\\';
+        *_buffer++ = escape;
+    }
 
-        while( _value )
-        {
-            js_integer_t symbol = _value % 10;
-            _value /= 10;
+    return _buffer;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_escape_size( js_string_t _value )
+{
+    const char * it_value = _value.value;
+    const char * it_value_end = _value.value + _value.size;
 
-            *--it = '0' + (char)symbol;
-        }
+    js_size_t value_size = _value.size;
 
-        *--it = '-';
-    }
-    else
+    for( ; (js_size_t)(it_value_end - it_value) >= JS_ESCAPE_CHUNK_SIZE; it_value += JS_ESCAPE_CHUNK_SIZE )
     {
-        while( _value )
+        if( __js_escape_chunk_clean( it_value ) == JS_TRUE )
         {
-            js_integer_t symbol = _value % 10;
-            _value /= 10;
+            continue;
+        }
 
-            *--it = '0' + (char)symbol;
+        for( uint32_t index = 0; index != JS_ESCAPE_CHUNK_SIZE; ++index )
+        {
+            value_size += __js_escape_char_size( it_value[index] ) - 1;
         }
     }
 
-    js_size_t symbols_size = JS_MAX_INTEGER_SYMBOLS - (it - symbols);
-
-    char * dst = JS_DUMP( _ctx, symbols_size );
-
-    if( dst == JS_NULLPTR )
+    for( ; it_value != it_value_end; ++it_value )
     {
-        return;
+        value_size += __js_escape_char_size( *it_value ) - 1;
     }
 
-    js_memcpy( dst, it, symbols_size );
+    return value_size;
 }
 //////////////////////////////////////////////////////////////////////////
-static void __js_dump_double( js_dump_ctx_t * _ctx, double _value, int32_t _precision )
+static void __js_escape_copy( char * _buffer, js_string_t _value )
 {
-    if( _value == 0.0 )
+    const char * it_value = _value.value;
+    const char * it_value_end = _value.value + _value.size;
+
+    char * it_buffer = _buffer;
+
+    for( ; (js_size_t)(it_value_end - it_value) >= JS_ESCAPE_CHUNK_SIZE; it_value += JS_ESCAPE_CHUNK_SIZE )
     {
-        JS_DUMP_INTERNAL( _ctx, "0.0" );
+        if( __js_escape_chunk_clean( it_value ) == JS_TRUE )
+        {
+            __js_escape_chunk_copy( it_buffer, it_value );
 
-        return;
+            it_buffer += JS_ESCAPE_CHUNK_SIZE;
+
+            continue;
+        }
+
+        for( uint32_t index = 0; index != JS_ESCAPE_CHUNK_SIZE; ++index )
+        {
+            it_buffer = __js_escape_char( it_buffer, it_value[index] );
+        }
     }
-    else if( _value == 0.5 )
-    {
-        JS_DUMP_INTERNAL( _ctx, "0.5" );
 
-        return;
+    for( ; it_value != it_value_end; ++it_value )
+    {
+        it_buffer = __js_escape_char( it_buffer, *it_value );
     }
-    else if( _value == 1.0 )
+}
+//////////////////////////////////////////////////////////////////////////
+static void * __js_dump_iovec_buffer( js_size_t _size, void * _ud );
+static js_result_t __js_dump_iovec_reference( const char * _value, js_size_t _size, void * _ud );
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_dump_string( js_dump_ctx_t * _ctx, js_string_t _value )
+{
+    js_size_t value_size = __js_escape_size( _value );
+
+    if( _ctx->buffer == &__js_dump_iovec_buffer && value_size == _value.size && value_size >= JS_DUMP_IOVEC_REFERENCE_SIZE )
     {
-        JS_DUMP_INTERNAL( _ctx, "1.0" );
+        js_result_t result = __js_dump_iovec_reference( _value.value, _value.size, _ctx->ud );
 
-        return;
+        return result;
     }
 
-    if( _value < 0.0 )
-    {
-        _value = -_value;
+    char * dst = JS_DUMP( _ctx, value_size );
 
-        __js_dump_char( _ctx, '-' );
+    if( dst == JS_NULLPTR )
+    {
+        return JS_FAILURE;
     }
 
-    double r = 0.0000000000000005;
-    double fr = _value + r;
+    __js_escape_copy( dst, _value );
 
-    int64_t i = (int64_t)fr;
-    fr -= (double)i;
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_string_internal( js_dump_ctx_t * _ctx, const char * _value, js_size_t _size )
+{
+    char * dst = JS_DUMP( _ctx, _size );
 
-    if( i == 0 )
+    if( dst == JS_NULLPTR )
     {
-        __js_dump_char( _ctx, '-' );
+        return;
     }
-    else
-    {
-        js_size_t n = 0;
-        
-        int64_t in = i;
-        while( in != 0 )
-        {
-            in /= 10;
-            ++n;
-        }
 
-        char * dst = JS_DUMP( _ctx, n );
+    js_memcpy( dst, _value, _size );
+}
+//////////////////////////////////////////////////////////////////////////
+#define JS_DUMP_INTERNAL(data, value) __js_dump_string_internal(data, value, sizeof( value ) - 1)
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_integer( js_dump_ctx_t * _ctx, js_integer_t _value )
+{
+    js_size_t symbols_size = js_format_integer_size( _value );
+
+    char * dst = JS_DUMP( _ctx, symbols_size );
 
-        if( dst == JS_NULLPTR )
-        {
-            return;
-        }
+    if( dst == JS_NULLPTR )
+    {
+        return;
+    }
 
-        char * p = dst + n;
+    js_format_integer( dst, _value );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_real( js_dump_ctx_t * _ctx, js_real_t _value )
+{
+    char symbols[JS_FORMAT_REAL_MAX_SIZE];
+    js_size_t symbols_size = js_format_real( symbols, _value, _ctx->precision );
 
-        while( n-- )
-        {
-            int64_t symbol = i % 10;
-            i /= 10;
+    __js_dump_string_internal( _ctx, symbols, symbols_size );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_element( js_dump_ctx_t * _ctx, const js_element_t * _element );
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_array_element( js_size_t _index, const js_element_t * _value, void * _ud )
+{
+    js_dump_ctx_t * ctx = (js_dump_ctx_t *)_ud;
 
-            *--p = '0' + (char)symbol;
-        }
+    if( _index != 0 )
+    {
+        __js_dump_char( ctx, ',' );
     }
 
-    __js_dump_char( _ctx, '.' );
+    __js_dump_element( ctx, _value );
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_dump_integers_t
+{
+    js_size_t size;
+    js_bool_t integers;
+    char * buffer;
+} js_dump_integers_t;
+//////////////////////////////////////////////////////////////////////////
+static void __js_measure_integers_element( js_size_t _index, const js_element_t * _value, void * _ud )
+{
+    js_dump_integers_t * integers = (js_dump_integers_t *)_ud;
 
-    if( fr == 0.0 )
+    if( integers->integers == JS_FALSE )
     {
-        __js_dump_char( _ctx, '0' );        
+        return;
     }
-    else
+
+    if( js_type( _value ) != js_type_integer )
     {
-        js_size_t n = 0;
-        js_size_t nz = 0;
+        integers->integers = JS_FALSE;
 
-        double frn = fr;
+        return;
+    }
 
-        while( _precision-- )
-        {
-            frn *= 10.0;
+    js_integer_t value = js_get_integer( _value );
 
-            char c = (char)frn;
-            frn -= c;
+    integers->size += js_format_integer_size( value ) + (_index != 0 ? 1 : 0);
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_integers_element( js_size_t _index, const js_element_t * _value, void * _ud )
+{
+    js_dump_integers_t * integers = (js_dump_integers_t *)_ud;
 
-            ++n;
+    if( _index != 0 )
+    {
+        *integers->buffer++ = ',';
+    }
 
-            if( c != 0 )
-            {
-                nz = n;
-            }
-        }
+    js_integer_t value = js_get_integer( _value );
 
-        if( nz == 0 )
-        {
-            __js_dump_char( _ctx, '0' );
-        }
-        else
-        {
-            char * dst = JS_DUMP( _ctx, nz );
+    integers->buffer += js_format_integer( integers->buffer, value );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_bool_t __js_dump_integers( js_dump_ctx_t * _ctx, const js_element_t * _element )
+{
+    js_dump_integers_t integers;
+    integers.size = 2;
+    integers.integers = JS_TRUE;
+    integers.buffer = JS_NULLPTR;
 
-            if( dst == JS_NULLPTR )
-            {
-                return;
-            }
+    js_array_foreach( _element, &__js_measure_integers_element, &integers );
 
-            while( nz-- )
-            {
-                fr *= 10.0;
+    if( integers.integers == JS_FALSE )
+    {
+        return JS_FALSE;
+    }
 
-                char c = (char)fr;
-                fr -= c;
+    char * dst = JS_DUMP( _ctx, integers.size );
 
-                *dst++ = '0' + c;
-            }
-        }
+    if( dst == JS_NULLPTR )
+    {
+        return JS_TRUE;
     }
+
+    integers.buffer = dst;
+
+    *integers.buffer++ = '[';
+    js_array_foreach( _element, &__js_dump_integers_element, &integers );
+    *integers.buffer++ = ']';
+
+    return JS_TRUE;
 }
 //////////////////////////////////////////////////////////////////////////
-static void __js_dump_element( js_dump_ctx_t * _ctx, const js_element_t * _element );
-//////////////////////////////////////////////////////////////////////////
-static void __js_dump_array_element( js_size_t _index, const js_element_t * _value, void * _ud )
+static js_bool_t __js_dump_source( js_dump_ctx_t * _ctx, const js_element_t * _element )
 {
-    js_dump_ctx_t * ctx = (js_dump_ctx_t *)_ud;
+    js_string_t source;
+    if( js_get_source( _element, &source ) == JS_FALSE )
+    {
+        return JS_FALSE;
+    }
 
-    if( _index != 0 )
+    if( _ctx->buffer == &__js_dump_iovec_buffer && source.size >= JS_DUMP_IOVEC_REFERENCE_SIZE )
     {
-        __js_dump_char( ctx, ',' );
+        __js_dump_iovec_reference( source.value, source.size, _ctx->ud );
+
+        return JS_TRUE;
     }
 
-    __js_dump_element( ctx, _value );
+    __js_dump_string_internal( _ctx, source.value, source.size );
+
+    return JS_TRUE;
 }
 //////////////////////////////////////////////////////////////////////////
 static void __js_dump_array( js_dump_ctx_t * _ctx, const js_element_t * _element )
 {
+    if( __js_dump_source( _ctx, _element ) == JS_TRUE )
+    {
+        return;
+    }
+
+    if( js_array_size( _element ) != 0 && __js_dump_integers( _ctx, _element ) == JS_TRUE )
+    {
+        return;
+    }
+
     __js_dump_char( _ctx, '[' );
     js_array_foreach( _element, &__js_dump_array_element, _ctx );
     __js_dump_char( _ctx, ']' );
@@ -314,6 +422,11 @@ static void __js_dump_object_element( js_size_t _index, const js_element_t * _ke
 //////////////////////////////////////////////////////////////////////////
 static void __js_dump_object( js_dump_ctx_t * _ctx, const js_element_t * _element )
 {
+    if( __js_dump_source( _ctx, _element ) == JS_TRUE )
+    {
+        return;
+    }
+
     __js_dump_char( _ctx, '{' );
     js_object_foreach( _element, &__js_dump_object_element, _ctx );
     __js_dump_char( _ctx, '}' );
@@ -347,7 +460,7 @@ static void __js_dump_element( js_dump_ctx_t * _ctx, const js_element_t * _eleme
         {
             js_real_t value = js_get_real( _element );
 
-            __js_dump_double( _ctx, value, 6 );
+            __js_dump_real( _ctx, value );
         }break;
     case js_type_string:
         {
@@ -391,12 +504,19 @@ void js_make_dump_ctx_buffer( js_buffer_t * _buffer, js_dump_ctx_t * const _ctx
 {
     _ctx->buffer = &__js_dump_buffer;
     _ctx->ud = _buffer;
+    _ctx->precision = 0;
 }
 //////////////////////////////////////////////////////////////////////////
 void js_make_dump_ctx_default( js_dump_buffer_fun_t _fun, void * _ud, js_dump_ctx_t * const _ctx )
 {
     _ctx->buffer = _fun;
     _ctx->ud = _ud;
+    _ctx->precision = 0;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_set_dump_ctx_precision( int32_t _precision, js_dump_ctx_t * const _ctx )
+{
+    _ctx->precision = _precision;
 }
 //////////////////////////////////////////////////////////////////////////
 js_result_t js_dump( const js_element_t * _element, js_dump_ctx_t * _ctx )
@@ -415,27 +535,1050 @@ js_result_t js_dump( const js_element_t * _element, js_dump_ctx_t * _ctx )
     return JS_SUCCESSFUL;
 }
 //////////////////////////////////////////////////////////////////////////
-js_result_t js_dump_string( js_string_t _value, char * const _buffer, js_size_t _capacity, js_size_t * const _size )
+typedef struct js_dump_iovec_t
 {
-    js_buffer_t dump_buff;
-    js_make_buffer( _buffer, _capacity, &dump_buff );
+    char * scratch;
+    char * scratch_end;
+    js_iovec_t * iovecs;
+    js_size_t count;
+    js_size_t capacity;
+    js_bool_t scratch_open;
+    js_bool_t failed;
+} js_dump_iovec_t;
+//////////////////////////////////////////////////////////////////////////
+static js_iovec_t * __js_dump_iovec_next( js_dump_iovec_t * _iovec )
+{
+    if( _iovec->count == _iovec->capacity )
+    {
+        _iovec->failed = JS_TRUE;
 
-    js_dump_ctx_t ctx;
-    js_make_dump_ctx_buffer( &dump_buff, &ctx );
+        return JS_NULLPTR;
+    }
 
-    js_result_t result = __js_dump_string( &ctx, _value );
+    js_iovec_t * iovec = _iovec->iovecs + _iovec->count++;
 
-    if( result != JS_SUCCESSFUL )
+    return iovec;
+}
+//////////////////////////////////////////////////////////////////////////
+static void * __js_dump_iovec_buffer( js_size_t _size, void * _ud )
+{
+    js_dump_iovec_t * iovec = (js_dump_iovec_t *)_ud;
+
+    if( (js_size_t)(iovec->scratch_end - iovec->scratch) < _size )
+    {
+        iovec->failed = JS_TRUE;
+
+        return JS_NULLPTR;
+    }
+
+    if( iovec->scratch_open == JS_TRUE )
+    {
+        iovec->iovecs[iovec->count - 1].size += _size;
+    }
+    else
+    {
+        js_iovec_t * next = __js_dump_iovec_next( iovec );
+
+        if( next == JS_NULLPTR )
+        {
+            return JS_NULLPTR;
+        }
+
+        next->base = iovec->scratch;
+        next->size = _size;
+
+        iovec->scratch_open = JS_TRUE;
+    }
+
+    char * new_buffer = iovec->scratch;
+
+    iovec->scratch += _size;
+
+    return new_buffer;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_dump_iovec_reference( const char * _value, js_size_t _size, void * _ud )
+{
+    js_dump_iovec_t * iovec = (js_dump_iovec_t *)_ud;
+
+    js_iovec_t * next = __js_dump_iovec_next( iovec );
+
+    if( next == JS_NULLPTR )
     {
         return JS_FAILURE;
     }
 
-    if( _size != JS_NULLPTR )
+    next->base = _value;
+    next->size = _size;
+
+    iovec->scratch_open = JS_FALSE;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_dump_iovec( const js_element_t * _element, char * const _scratch, js_size_t _scratch_capacity, js_iovec_t * const _iovecs, js_size_t _iovec_capacity, js_size_t * const _iovec_count )
+{
+    js_dump_iovec_t iovec;
+    iovec.scratch = _scratch;
+    iovec.scratch_end = _scratch + _scratch_capacity;
+    iovec.iovecs = _iovecs;
+    iovec.count = 0;
+    iovec.capacity = _iovec_capacity;
+    iovec.scratch_open = JS_FALSE;
+    iovec.failed = JS_FALSE;
+
+    js_dump_ctx_t ctx;
+    js_make_dump_ctx_default( &__js_dump_iovec_buffer, &iovec, &ctx );
+
+    __js_dump_object( &ctx, _element );
+
+    if( iovec.failed == JS_TRUE )
     {
-        *_size = js_get_buffer_size( &dump_buff );
+        return JS_FAILURE;
     }
 
+    *_iovec_count = iovec.count;
+
     return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_dump_measure_t
+{
+    js_size_t size;
+    int32_t precision;
+} js_dump_measure_t;
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_measure_element( const js_element_t * _element, int32_t _precision );
+//////////////////////////////////////////////////////////////////////////
+static void __js_measure_array_element( js_size_t _index, const js_element_t * _value, void * _ud )
+{
+    js_dump_measure_t * measure = (js_dump_measure_t *)_ud;
+
+    if( _index != 0 )
+    {
+        measure->size += 1;
+    }
+
+    measure->size += __js_measure_element( _value, measure->precision );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_measure_object_element( js_size_t _index, const js_element_t * _key, const js_element_t * _value, void * _ud )
+{
+    js_dump_measure_t * measure = (js_dump_measure_t *)_ud;
+
+    if( _index != 0 )
+    {
+        measure->size += 1;
+    }
+
+    js_string_t key;
+    js_get_string( _key, &key );
+
+    measure->size += __js_escape_size( key ) + 3;
+
+    measure->size += __js_measure_element( _value, measure->precision );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_measure_object( const js_element_t * _element, int32_t _precision )
+{
+    js_string_t source;
+    if( js_get_source( _element, &source ) == JS_TRUE )
+    {
+        return source.size;
+    }
+
+    js_dump_measure_t measure;
+    measure.size = 2;
+    measure.precision = _precision;
+
+    js_object_foreach( _element, &__js_measure_object_element, &measure );
+
+    return measure.size;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_measure_element( const js_element_t * _element, int32_t _precision )
+{
+    js_type_t type = js_type( _element );
+
+    switch( type )
+    {
+    case js_type_null:
+        return sizeof( "null" ) - 1;
+    case js_type_false:
+        return sizeof( "false" ) - 1;
+    case js_type_true:
+        return sizeof( "true" ) - 1;
+    case js_type_integer:
+        {
+            js_integer_t value = js_get_integer( _element );
+
+            js_size_t symbols_size = js_format_integer_size( value );
+
+            return symbols_size;
+        }
+    case js_type_real:
+        {
+            js_real_t value = js_get_real( _element );
+
+            char symbols[JS_FORMAT_REAL_MAX_SIZE];
+            js_size_t symbols_size = js_format_real( symbols, value, _precision );
+
+            return symbols_size;
+        }
+    case js_type_string:
+        {
+            js_string_t str;
+            js_get_string( _element, &str );
+
+            js_size_t size = __js_escape_size( str ) + 2;
+
+            return size;
+        }
+    case js_type_array:
+        {
+            js_string_t source;
+            if( js_get_source( _element, &source ) == JS_TRUE )
+            {
+                return source.size;
+            }
+
+            js_dump_measure_t measure;
+            measure.size = 2;
+            measure.precision = _precision;
+
+            js_array_foreach( _element, &__js_measure_array_element, &measure );
+
+            return measure.size;
+        }
+    case js_type_object:
+        {
+            js_size_t size = __js_measure_object( _element, _precision );
+
+            return size;
+        }
+    }
+
+    return 0;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_dump_measure( const js_element_t * _element, js_size_t * const _size )
+{
+    *_size = __js_measure_object( _element, 0 );
+}
+//////////////////////////////////////////////////////////////////////////
+static void * __js_dump_unchecked( js_size_t _size, void * _ud )
+{
+    char ** memory = (char **)_ud;
+
+    char * new_buffer = *memory;
+
+    *memory += _size;
+
+    return new_buffer;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_dump_alloc( const js_element_t * _element, js_allocator_t _allocator, char ** const _buffer, js_size_t * const _size )
+{
+    js_size_t size;
+    js_dump_measure( _element, &size );
+
+    char * buffer = (char *)_allocator.alloc( size + 1, _allocator.ud );
+
+    if( buffer == JS_NULLPTR )
+    {
+        return JS_FAILURE;
+    }
+
+    char * memory = buffer;
+
+    js_dump_ctx_t ctx;
+    js_make_dump_ctx_default( &__js_dump_unchecked, &memory, &ctx );
+
+    js_dump( _element, &ctx );
+
+    *_buffer = buffer;
+
+    if( _size != JS_NULLPTR )
+    {
+        *_size = size;
+    }
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_dump_string( js_string_t _value, char * const _buffer, js_size_t _capacity, js_size_t * const _size )
+{
+    js_buffer_t dump_buff;
+    js_make_buffer( _buffer, _capacity, &dump_buff );
+
+    js_dump_ctx_t ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &ctx );
+
+    js_result_t result = __js_dump_string( &ctx, _value );
+
+    if( result != JS_SUCCESSFUL )
+    {
+        return JS_FAILURE;
+    }
+
+    if( _size != JS_NULLPTR )
+    {
+        *_size = js_get_buffer_size( &dump_buff );
+    }
+
+    return JS_SUCCESSFUL;
+
+}
+//////////////////////////////////////////////////////////////////////////
+void js_make_writer( js_dump_ctx_t * _ctx, js_writer_t * const _writer )
+{
+    _writer->ctx = _ctx;
+    _writer->depth = 0;
+    _writer->first = JS_TRUE;
+    _writer->key = JS_FALSE;
+    _writer->failed = JS_FALSE;
+}
+//////////////////////////////////////////////////////////////////////////
+static char * __js_writer_reserve( js_writer_t * _writer, js_size_t _size )
+{
+    char * dst = JS_DUMP( _writer->ctx, _size );
+
+    if( dst == JS_NULLPTR )
+    {
+        _writer->failed = JS_TRUE;
+    }
+
+    return dst;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_writer_prefix( js_writer_t * _writer, js_bool_t _key )
+{
+    if( _writer->failed == JS_TRUE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( _writer->depth == 0 )
+    {
+        if( _key == JS_TRUE || _writer->first == JS_FALSE )
+        {
+            return JS_FAILURE;
+        }
+
+        _writer->first = JS_FALSE;
+
+        return JS_SUCCESSFUL;
+    }
+
+    js_type_t container = _writer->stack[_writer->depth - 1];
+
+    if( container == js_type_object && _key == JS_FALSE )
+    {
+        if( _writer->key == JS_FALSE )
+        {
+            return JS_FAILURE;
+        }
+
+        _writer->key = JS_FALSE;
+
+        return JS_SUCCESSFUL;
+    }
+
+    if( container == js_type_object && _writer->key == JS_TRUE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( container == js_type_array && _key == JS_TRUE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( _writer->first == JS_FALSE )
+    {
+        char * dst = __js_writer_reserve( _writer, 1 );
+
+        if( dst == JS_NULLPTR )
+        {
+            return JS_FAILURE;
+        }
+
+        *dst = ',';
+    }
+
+    _writer->first = JS_FALSE;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_writer_raw( js_writer_t * _writer, const char * _value, js_size_t _size )
+{
+    char * dst = __js_writer_reserve( _writer, _size );
+
+    if( dst == JS_NULLPTR )
+    {
+        return JS_FAILURE;
+    }
+
+    js_memcpy( dst, _value, _size );
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_writer_begin( js_writer_t * _writer, js_type_t _type, char _open )
+{
+    if( _writer->depth == JS_WRITER_MAX_DEPTH )
+    {
+        _writer->failed = JS_TRUE;
+
+        return JS_FAILURE;
+    }
+
+    if( __js_writer_prefix( _writer, JS_FALSE ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( __js_writer_raw( _writer, &_open, 1 ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    _writer->stack[_writer->depth++] = (uint8_t)_type;
+    _writer->first = JS_TRUE;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_writer_end( js_writer_t * _writer, js_type_t _type, char _close )
+{
+    if( _writer->failed == JS_TRUE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( _writer->depth == 0 || _writer->stack[_writer->depth - 1] != _type || _writer->key == JS_TRUE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( __js_writer_raw( _writer, &_close, 1 ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    --_writer->depth;
+    _writer->first = JS_FALSE;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_result_t __js_writer_string( js_writer_t * _writer, js_string_t _value )
+{
+    js_size_t value_size = __js_escape_size( _value );
+
+    char * dst = __js_writer_reserve( _writer, value_size + 2 );
+
+    if( dst == JS_NULLPTR )
+    {
+        return JS_FAILURE;
+    }
+
+    dst[0] = '"';
+    __js_escape_copy( dst + 1, _value );
+    dst[value_size + 1] = '"';
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_object_begin( js_writer_t * _writer )
+{
+    js_result_t result = __js_writer_begin( _writer, js_type_object, '{' );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_object_end( js_writer_t * _writer )
+{
+    js_result_t result = __js_writer_end( _writer, js_type_object, '}' );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_array_begin( js_writer_t * _writer )
+{
+    js_result_t result = __js_writer_begin( _writer, js_type_array, '[' );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_array_end( js_writer_t * _writer )
+{
+    js_result_t result = __js_writer_end( _writer, js_type_array, ']' );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_key( js_writer_t * _writer, const char * _key )
+{
+    js_string_t key;
+    key.value = _key;
+    key.size = js_strlen( _key );
+
+    js_result_t result = js_write_keyn( _writer, key );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_keyn( js_writer_t * _writer, js_string_t _key )
+{
+    if( __js_writer_prefix( _writer, JS_TRUE ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( __js_writer_string( _writer, _key ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( __js_writer_raw( _writer, ":", 1 ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    _writer->key = JS_TRUE;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_null( js_writer_t * _writer )
+{
+    if( __js_writer_prefix( _writer, JS_FALSE ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    js_result_t result = __js_writer_raw( _writer, "null", sizeof( "null" ) - 1 );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_boolean( js_writer_t * _writer, js_bool_t _value )
+{
+    if( __js_writer_prefix( _writer, JS_FALSE ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    if( _value == JS_TRUE )
+    {
+        js_result_t result = __js_writer_raw( _writer, "true", sizeof( "true" ) - 1 );
+
+        return result;
+    }
+
+    js_result_t result = __js_writer_raw( _writer, "false", sizeof( "false" ) - 1 );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_integer( js_writer_t * _writer, js_integer_t _value )
+{
+    if( __js_writer_prefix( _writer, JS_FALSE ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    js_size_t symbols_size = js_format_integer_size( _value );
+
+    char * dst = __js_writer_reserve( _writer, symbols_size );
+
+    if( dst == JS_NULLPTR )
+    {
+        return JS_FAILURE;
+    }
+
+    js_format_integer( dst, _value );
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_real( js_writer_t * _writer, js_real_t _value )
+{
+    if( __js_writer_prefix( _writer, JS_FALSE ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    char symbols[JS_FORMAT_REAL_MAX_SIZE];
+    js_size_t symbols_size = js_format_real( symbols, _value, _writer->ctx->precision );
+
+    js_result_t result = __js_writer_raw( _writer, symbols, symbols_size );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_string( js_writer_t * _writer, const char * _value )
+{
+    js_string_t value;
+    value.value = _value;
+    value.size = js_strlen( _value );
+
+    js_result_t result = js_write_stringn( _writer, value );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_stringn( js_writer_t * _writer, js_string_t _value )
+{
+    if( __js_writer_prefix( _writer, JS_FALSE ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    js_result_t result = __js_writer_string( _writer, _value );
+
+    return result;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_element( js_writer_t * _writer, const js_element_t * _element )
+{
+    if( __js_writer_prefix( _writer, JS_FALSE ) == JS_FAILURE )
+    {
+        return JS_FAILURE;
+    }
+
+    int32_t precision = _writer->ctx->precision;
+
+    js_size_t size = __js_measure_element( _element, precision );
+
+    char * dst = __js_writer_reserve( _writer, size );
+
+    if( dst == JS_NULLPTR )
+    {
+        return JS_FAILURE;
+    }
+
+    char * memory = dst;
+
+    js_dump_ctx_t ctx;
+    js_make_dump_ctx_default( &__js_dump_unchecked, &memory, &ctx );
+    js_set_dump_ctx_precision( precision, &ctx );
+
+    __js_dump_element( &ctx, _element );
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_write_finish( js_writer_t * _writer )
+{
+    if( _writer->failed == JS_TRUE || _writer->depth != 0 || _writer->first == JS_TRUE )
+    {
+        return JS_FAILURE;
+    }
+
+    char * dst = __js_writer_reserve( _writer, 1 );
+
+    if( dst == JS_NULLPTR )
+    {
+        return JS_FAILURE;
+    }
+
+    *dst = '\0';
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_container_size( const js_element_t * _element )
+{
+    js_type_t type = js_type( _element );
+
+    if( type == js_type_array )
+    {
+        js_size_t size = js_array_size( _element );
+
+        return size;
+    }
+    else if( type == js_type_object )
+    {
+        js_size_t size = js_object_size( _element );
+
+        return size;
+    }
+
+    return 0;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __js_measure_chunk( const js_dump_chunk_t * _chunk )
+{
+    js_dump_measure_t measure;
+    measure.size = 0;
+    measure.precision = 0;
+
+    if( _chunk->first == JS_TRUE )
+    {
+        measure.size += 1;
+    }
+
+    if( _chunk->key != JS_NULLPTR && _chunk->begin == 0 )
+    {
+        js_string_t key;
+        js_get_string( _chunk->key, &key );
+
+        measure.size += (_chunk->field != 0 ? 1 : 0) + __js_escape_size( key ) + 4;
+    }
+
+    js_type_t type = js_type( _chunk->container );
+
+    js_iterator_t iterator = _chunk->iterator;
+
+    for( js_size_t index = _chunk->begin; index != _chunk->end; ++index )
+    {
+        const js_element_t * key;
+        const js_element_t * value;
+        js_iterator_next( &iterator, &key, &value );
+
+        if( type == js_type_array )
+        {
+            __js_measure_array_element( index, value, &measure );
+        }
+        else
+        {
+            __js_measure_object_element( index, key, value, &measure );
+        }
+    }
+
+    if( _chunk->key != JS_NULLPTR && _chunk->end == __js_container_size( _chunk->container ) )
+    {
+        measure.size += 1;
+    }
+
+    if( _chunk->last == JS_TRUE )
+    {
+        measure.size += 1;
+    }
+
+    return measure.size;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_dump_chunk( js_dump_chunk_t * _chunk )
+{
+    js_size_t size = __js_measure_chunk( _chunk );
+
+    char * buffer = (char *)_chunk->allocator.alloc( size, _chunk->allocator.ud );
+
+    if( buffer == JS_NULLPTR )
+    {
+        _chunk->result = JS_FAILURE;
+
+        return JS_FAILURE;
+    }
+
+    char * memory = buffer;
+
+    js_dump_ctx_t ctx;
+    js_make_dump_ctx_default( &__js_dump_unchecked, &memory, &ctx );
+
+    if( _chunk->first == JS_TRUE )
+    {
+        __js_dump_char( &ctx, '{' );
+    }
+
+    js_type_t type = js_type( _chunk->container );
+
+    if( _chunk->key != JS_NULLPTR && _chunk->begin == 0 )
+    {
+        if( _chunk->field != 0 )
+        {
+            __js_dump_char( &ctx, ',' );
+        }
+
+        js_string_t key;
+        js_get_string( _chunk->key, &key );
+
+        __js_dump_char( &ctx, '"' );
+        __js_dump_string( &ctx, key );
+        __js_dump_char( &ctx, '"' );
+        __js_dump_char( &ctx, ':' );
+        __js_dump_char( &ctx, type == js_type_array ? '[' : '{' );
+    }
+
+    js_iterator_t iterator = _chunk->iterator;
+
+    for( js_size_t index = _chunk->begin; index != _chunk->end; ++index )
+    {
+        const js_element_t * key;
+        const js_element_t * value;
+        js_iterator_next( &iterator, &key, &value );
+
+        if( type == js_type_array )
+        {
+            __js_dump_array_element( index, value, &ctx );
+        }
+        else
+        {
+            __js_dump_object_element( index, key, value, &ctx );
+        }
+    }
+
+    if( _chunk->key != JS_NULLPTR && _chunk->end == __js_container_size( _chunk->container ) )
+    {
+        __js_dump_char( &ctx, type == js_type_array ? ']' : '}' );
+    }
+
+    if( _chunk->last == JS_TRUE )
+    {
+        __js_dump_char( &ctx, '}' );
+    }
+
+    _chunk->buffer = buffer;
+    _chunk->size = size;
+    _chunk->result = JS_SUCCESSFUL;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_dump_plan_t
+{
+    const js_element_t * root;
+    js_allocator_t allocator;
+    js_size_t split;
+    js_size_t pending;
+    js_iterator_t pending_iterator;
+    js_dump_chunk_t * chunks;
+    js_size_t count;
+} js_dump_plan_t;
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_plan_add( js_dump_plan_t * _plan, const js_element_t * _container, const js_element_t * _key, js_size_t _field, js_size_t _begin, js_size_t _end, const js_iterator_t * _iterator )
+{
+    if( _plan->chunks != JS_NULLPTR )
+    {
+        js_dump_chunk_t * chunk = _plan->chunks + _plan->count;
+
+        chunk->container = _container;
+        chunk->key = _key;
+        chunk->field = _field;
+        chunk->begin = _begin;
+        chunk->end = _end;
+        chunk->iterator = *_iterator;
+        chunk->first = JS_FALSE;
+        chunk->last = JS_FALSE;
+        chunk->allocator = _plan->allocator;
+        chunk->buffer = JS_NULLPTR;
+        chunk->size = 0;
+        chunk->result = JS_FAILURE;
+    }
+
+    ++_plan->count;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_plan_flush( js_dump_plan_t * _plan, js_size_t _index )
+{
+    if( _plan->pending == _index )
+    {
+        return;
+    }
+
+    __js_dump_plan_add( _plan, _plan->root, JS_NULLPTR, 0, _plan->pending, _index, &_plan->pending_iterator );
+
+    _plan->pending = _index;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_plan_split( js_dump_plan_t * _plan, js_size_t _index, const js_element_t * _key, const js_element_t * _value, js_size_t _size )
+{
+    js_iterator_t iterator;
+
+    if( js_type( _value ) == js_type_array )
+    {
+        js_array_begin( _value, &iterator );
+    }
+    else
+    {
+        js_object_begin( _value, &iterator );
+    }
+
+    for( js_size_t begin = 0; begin < _size; begin += _plan->split )
+    {
+        js_size_t end = begin + _plan->split < _size ? begin + _plan->split : _size;
+
+        __js_dump_plan_add( _plan, _value, _key, _index, begin, end, &iterator );
+
+        if( _plan->chunks == JS_NULLPTR )
+        {
+            continue;
+        }
+
+        for( js_size_t skip = begin; skip != end; ++skip )
+        {
+            const js_element_t * skip_key;
+            const js_element_t * skip_value;
+            js_iterator_next( &iterator, &skip_key, &skip_value );
+        }
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_plan_field( js_dump_plan_t * _plan, js_size_t _index, const js_element_t * _key, const js_element_t * _value, const js_iterator_t * _next )
+{
+    js_size_t size = __js_container_size( _value );
+
+    if( size < JS_DUMP_PARALLEL_SPLIT_SIZE )
+    {
+        if( _index + 1 - _plan->pending >= _plan->split )
+        {
+            __js_dump_plan_flush( _plan, _index + 1 );
+
+            _plan->pending_iterator = *_next;
+        }
+
+        return;
+    }
+
+    __js_dump_plan_flush( _plan, _index );
+
+    __js_dump_plan_split( _plan, _index, _key, _value, size );
+
+    _plan->pending = _index + 1;
+    _plan->pending_iterator = *_next;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_plan( js_dump_plan_t * _plan )
+{
+    _plan->pending = 0;
+    _plan->count = 0;
+
+    js_object_begin( _plan->root, &_plan->pending_iterator );
+
+    js_iterator_t iterator = _plan->pending_iterator;
+
+    const js_element_t * key;
+    const js_element_t * value;
+
+    for( js_size_t index = 0; js_iterator_next( &iterator, &key, &value ) == JS_TRUE; ++index )
+    {
+        __js_dump_plan_field( _plan, index, key, value, &iterator );
+    }
+
+    __js_dump_plan_flush( _plan, js_object_size( _plan->root ) );
+
+    if( _plan->count == 0 )
+    {
+        __js_dump_plan_add( _plan, _plan->root, JS_NULLPTR, 0, 0, 0, &_plan->pending_iterator );
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_dump_largest_field( js_size_t _index, const js_element_t * _key, const js_element_t * _value, void * _ud )
+{
+    JS_UNUSED( _index );
+    JS_UNUSED( _key );
+
+    js_size_t * largest = (js_size_t *)_ud;
+
+    js_size_t size = __js_container_size( _value );
+
+    if( *largest < size )
+    {
+        *largest = size;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_dump_parallel( const js_element_t * _element, js_allocator_t _allocator, js_size_t _concurrency, js_dump_parallel_fun_t _fun, void * _ud, js_dump_chunk_t ** const _chunks, js_size_t * const _count )
+{
+    js_size_t largest = 0;
+    js_object_foreach( _element, &__js_dump_largest_field, &largest );
+
+    js_size_t target = (_concurrency != 0 ? _concurrency : 1) * JS_DUMP_PARALLEL_CHUNKS_PER_WORKER;
+
+    js_dump_plan_t plan;
+    plan.root = _element;
+    plan.allocator = _allocator;
+    plan.split = largest / target > JS_DUMP_PARALLEL_SPLIT_SIZE ? largest / target : JS_DUMP_PARALLEL_SPLIT_SIZE;
+    plan.chunks = JS_NULLPTR;
+
+    __js_dump_plan( &plan );
+
+    js_dump_chunk_t * chunks = (js_dump_chunk_t *)_allocator.alloc( sizeof( js_dump_chunk_t ) * plan.count, _allocator.ud );
+
+    if( chunks == JS_NULLPTR )
+    {
+        return JS_FAILURE;
+    }
+
+    plan.chunks = chunks;
+
+    __js_dump_plan( &plan );
+
+    chunks[0].first = JS_TRUE;
+    chunks[plan.count - 1].last = JS_TRUE;
+
+    if( _fun != JS_NULLPTR )
+    {
+        (*_fun)(chunks, plan.count, _ud);
+    }
+    else
+    {
+        for( js_size_t index = 0; index != plan.count; ++index )
+        {
+            js_dump_chunk( chunks + index );
+        }
+    }
+
+    for( js_size_t index = 0; index != plan.count; ++index )
+    {
+        if( chunks[index].result == JS_FAILURE )
+        {
+            js_dump_chunks_free( _allocator, chunks, plan.count );
+
+            return JS_FAILURE;
+        }
+    }
+
+    *_chunks = chunks;
+    *_count = plan.count;
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+js_result_t js_dump_chunks_concat( const js_dump_chunk_t * _chunks, js_size_t _count, js_dump_ctx_t * _ctx )
+{
+    for( js_size_t index = 0; index != _count; ++index )
+    {
+        const js_dump_chunk_t * chunk = _chunks + index;
+
+        char * dst = JS_DUMP( _ctx, chunk->size );
+
+        if( dst == JS_NULLPTR )
+        {
+            return JS_FAILURE;
+        }
+
+        js_memcpy( dst, chunk->buffer, chunk->size );
+    }
+
+    char * dst = JS_DUMP( _ctx, 1 );
+
+    if( dst == JS_NULLPTR )
+    {
+        return JS_FAILURE;
+    }
+
+    *dst = '\0';
+
+    return JS_SUCCESSFUL;
+}
+//////////////////////////////////////////////////////////////////////////
+void js_dump_chunks_free( js_allocator_t _allocator, js_dump_chunk_t * _chunks, js_size_t _count )
+{
+    for( js_size_t index = 0; index != _count; ++index )
+    {
+        const js_dump_chunk_t * chunk = _chunks + index;
+
+        if( chunk->buffer != JS_NULLPTR )
+        {
+            _allocator.free( chunk->buffer, _allocator.ud );
+        }
+    }
 
+    _allocator.free( _chunks, _allocator.ud );
 }
 //////////////////////////////////////////////////////////////////////////
\ No newline at end of file
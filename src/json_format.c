@@ -0,0 +1,655 @@
+#include "json_format.h"
+
+//////////////////////////////////////////////////////////////////////////
+// Grisu2 (Florian Loitsch, "Printing Floating-Point Numbers Quickly and
+// Accurately with Integers") producing a digit string that always reads
+// back to the same double; it is usually, but not always, the shortest one.
+//
+// The Grisu2, cached powers and Prettify code below is ported from
+// RapidJSON (include/rapidjson/internal/dtoa.h, diyfp.h):
+//
+// Tencent is pleased to support the open source community by making
+// RapidJSON available.
+//
+// Copyright (C) 2015 THL A29 Limited, a Tencent company, and Milo Yip.
+// All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file
+// except in compliance with the License. You may obtain a copy of the
+// License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//////////////////////////////////////////////////////////////////////////
+#define JS_REAL_SIGNIFICAND_SIZE 52
+#define JS_REAL_EXPONENT_BIAS (0x3FF + JS_REAL_SIGNIFICAND_SIZE)
+#define JS_REAL_DENORMAL_EXPONENT (-JS_REAL_EXPONENT_BIAS + 1)
+#define JS_REAL_EXPONENT_MASK 0x7FF0000000000000ULL
+#define JS_REAL_SIGNIFICAND_MASK 0x000FFFFFFFFFFFFFULL
+#define JS_REAL_HIDDEN_BIT 0x0010000000000000ULL
+#define JS_REAL_MAX_DECIMAL_PLACES 324
+//////////////////////////////////////////////////////////////////////////
+typedef struct js_diyfp_t
+{
+    uint64_t f;
+    int32_t e;
+} js_diyfp_t;
+//////////////////////////////////////////////////////////////////////////
+static const uint64_t __js_cached_powers_f[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+    0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+    0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+    0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+    0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+    0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+    0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+    0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+    0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+    0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+    0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+    0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+    0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+    0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+    0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+//////////////////////////////////////////////////////////////////////////
+static const int16_t __js_cached_powers_e[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034,
+    -1007, -980, -954, -927, -901, -874, -847, -821,
+    -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396,
+    -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242,
+    269, 295, 322, 348, 375, 402, 428, 455,
+    481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+//////////////////////////////////////////////////////////////////////////
+static const uint64_t __js_pow10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+//////////////////////////////////////////////////////////////////////////
+static const char __js_digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+//////////////////////////////////////////////////////////////////////////
+static uint32_t __js_bit_length( uint64_t _value )
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 64 - (uint32_t)__builtin_clzll( _value | 1 );
+#else
+    uint32_t length = 1;
+
+    while( _value >>= 1 )
+    {
+        ++length;
+    }
+
+    return length;
+#endif
+}
+//////////////////////////////////////////////////////////////////////////
+static uint32_t __js_count_digits64( uint64_t _value )
+{
+    // log10(2) ~ 1233 / 4096
+    uint32_t t = __js_bit_length( _value ) * 1233 >> 12;
+
+    uint32_t digits = t + 1 - (_value < __js_pow10[t] ? 1 : 0);
+
+    if( digits == 0 )
+    {
+        return 1;
+    }
+
+    return digits;
+}
+//////////////////////////////////////////////////////////////////////////
+static uint64_t __js_integer_magnitude( js_integer_t _value )
+{
+    if( _value < 0 )
+    {
+        return 0 - (uint64_t)_value;
+    }
+
+    return (uint64_t)_value;
+}
+//////////////////////////////////////////////////////////////////////////
+js_size_t js_format_integer_size( js_integer_t _value )
+{
+    uint64_t magnitude = __js_integer_magnitude( _value );
+
+    js_size_t size = __js_count_digits64( magnitude ) + (_value < 0 ? 1 : 0);
+
+    return size;
+}
+//////////////////////////////////////////////////////////////////////////
+js_size_t js_format_integer( char * const _buffer, js_integer_t _value )
+{
+    uint64_t magnitude = __js_integer_magnitude( _value );
+
+    js_size_t size = __js_count_digits64( magnitude );
+
+    char * it = _buffer;
+
+    if( _value < 0 )
+    {
+        *it++ = '-';
+    }
+
+    char * end = it + size;
+    char * p = end;
+
+    while( magnitude >= 100 )
+    {
+        const char * pair = __js_digit_pairs + (magnitude % 100) * 2;
+
+        magnitude /= 100;
+
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+
+    if( magnitude >= 10 )
+    {
+        const char * pair = __js_digit_pairs + magnitude * 2;
+
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    else
+    {
+        *--p = (char)('0' + magnitude);
+    }
+
+    return end - _buffer;
+}
+//////////////////////////////////////////////////////////////////////////
+static uint64_t __js_real_bits( double _value )
+{
+    union
+    {
+        double d;
+        uint64_t u;
+    } bits;
+
+    bits.d = _value;
+
+    return bits.u;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_diyfp_t __js_diyfp_make( uint64_t _f, int32_t _e )
+{
+    js_diyfp_t fp;
+    fp.f = _f;
+    fp.e = _e;
+
+    return fp;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_diyfp_t __js_diyfp_from_real( double _value )
+{
+    uint64_t u = __js_real_bits( _value );
+
+    int32_t biased_e = (int32_t)((u & JS_REAL_EXPONENT_MASK) >> JS_REAL_SIGNIFICAND_SIZE);
+    uint64_t significand = u & JS_REAL_SIGNIFICAND_MASK;
+
+    if( biased_e != 0 )
+    {
+        js_diyfp_t fp = __js_diyfp_make( significand + JS_REAL_HIDDEN_BIT, biased_e - JS_REAL_EXPONENT_BIAS );
+
+        return fp;
+    }
+
+    js_diyfp_t fp = __js_diyfp_make( significand, JS_REAL_DENORMAL_EXPONENT );
+
+    return fp;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_diyfp_t __js_diyfp_multiply( js_diyfp_t _a, js_diyfp_t _b )
+{
+    const uint64_t M32 = 0xFFFFFFFFULL;
+
+    uint64_t a = _a.f >> 32;
+    uint64_t b = _a.f & M32;
+    uint64_t c = _b.f >> 32;
+    uint64_t d = _b.f & M32;
+
+    uint64_t ac = a * c;
+    uint64_t bc = b * c;
+    uint64_t ad = a * d;
+    uint64_t bd = b * d;
+
+    uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+    tmp += 1ULL << 31;
+
+    js_diyfp_t fp = __js_diyfp_make( ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), _a.e + _b.e + 64 );
+
+    return fp;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_diyfp_t __js_diyfp_normalize( js_diyfp_t _fp )
+{
+    while( (_fp.f & (1ULL << 63)) == 0 )
+    {
+        _fp.f <<= 1;
+        _fp.e--;
+    }
+
+    return _fp;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_diyfp_t __js_diyfp_normalize_boundary( js_diyfp_t _fp )
+{
+    while( (_fp.f & (JS_REAL_HIDDEN_BIT << 1)) == 0 )
+    {
+        _fp.f <<= 1;
+        _fp.e--;
+    }
+
+    _fp.f <<= 64 - JS_REAL_SIGNIFICAND_SIZE - 2;
+    _fp.e -= 64 - JS_REAL_SIGNIFICAND_SIZE - 2;
+
+    return _fp;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_diyfp_boundaries( js_diyfp_t _fp, js_diyfp_t * const _minus, js_diyfp_t * const _plus )
+{
+    js_diyfp_t plus = __js_diyfp_normalize_boundary( __js_diyfp_make( (_fp.f << 1) + 1, _fp.e - 1 ) );
+
+    js_diyfp_t minus = (_fp.f == JS_REAL_HIDDEN_BIT)
+        ? __js_diyfp_make( (_fp.f << 2) - 1, _fp.e - 2 )
+        : __js_diyfp_make( (_fp.f << 1) - 1, _fp.e - 1 );
+
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    *_plus = plus;
+    *_minus = minus;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_diyfp_t __js_cached_power( int32_t _e, int32_t * const _k )
+{
+    double dk = (-61 - _e) * 0.30102999566398114 + 347;
+
+    int32_t k = (int32_t)dk;
+
+    if( dk - k > 0.0 )
+    {
+        k++;
+    }
+
+    uint32_t index = (uint32_t)((k >> 3) + 1);
+
+    *_k = -(-348 + (int32_t)(index << 3));
+
+    js_diyfp_t fp = __js_diyfp_make( __js_cached_powers_f[index], __js_cached_powers_e[index] );
+
+    return fp;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_grisu_round( char * _buffer, int32_t _size, uint64_t _delta, uint64_t _rest, uint64_t _ten_kappa, uint64_t _wp_w )
+{
+    while( _rest < _wp_w && _delta - _rest >= _ten_kappa
+        && (_rest + _ten_kappa < _wp_w || _wp_w - _rest > _rest + _ten_kappa - _wp_w) )
+    {
+        _buffer[_size - 1]--;
+
+        _rest += _ten_kappa;
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static int32_t __js_count_digits32( uint32_t _value )
+{
+    int32_t digits = 1;
+
+    while( digits != 10 && _value >= __js_pow10[digits] )
+    {
+        ++digits;
+    }
+
+    return digits;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_grisu_digits( js_diyfp_t _w, js_diyfp_t _mp, uint64_t _delta, char * _buffer, int32_t * const _size, int32_t * const _k )
+{
+    js_diyfp_t one = __js_diyfp_make( 1ULL << -_mp.e, _mp.e );
+
+    uint64_t wp_w = _mp.f - _w.f;
+
+    uint32_t p1 = (uint32_t)(_mp.f >> -one.e);
+    uint64_t p2 = _mp.f & (one.f - 1);
+
+    int32_t kappa = __js_count_digits32( p1 );
+
+    int32_t size = 0;
+
+    while( kappa > 0 )
+    {
+        uint32_t pow10 = (uint32_t)__js_pow10[kappa - 1];
+
+        uint32_t d = p1 / pow10;
+        p1 %= pow10;
+
+        if( d != 0 || size != 0 )
+        {
+            _buffer[size++] = (char)('0' + d);
+        }
+
+        kappa--;
+
+        uint64_t tmp = ((uint64_t)p1 << -one.e) + p2;
+
+        if( tmp <= _delta )
+        {
+            *_k += kappa;
+            *_size = size;
+
+            __js_grisu_round( _buffer, size, _delta, tmp, __js_pow10[kappa] << -one.e, wp_w );
+
+            return;
+        }
+    }
+
+    for( ;; )
+    {
+        p2 *= 10;
+        _delta *= 10;
+
+        char d = (char)(p2 >> -one.e);
+
+        if( d != 0 || size != 0 )
+        {
+            _buffer[size++] = (char)('0' + d);
+        }
+
+        p2 &= one.f - 1;
+
+        kappa--;
+
+        if( p2 < _delta )
+        {
+            *_k += kappa;
+            *_size = size;
+
+            int32_t index = -kappa;
+
+            __js_grisu_round( _buffer, size, _delta, p2, one.f, wp_w * (index < 20 ? __js_pow10[index] : 0) );
+
+            return;
+        }
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_grisu2( double _value, char * _buffer, int32_t * const _size, int32_t * const _k )
+{
+    js_diyfp_t v = __js_diyfp_from_real( _value );
+
+    js_diyfp_t w_m;
+    js_diyfp_t w_p;
+    __js_diyfp_boundaries( v, &w_m, &w_p );
+
+    js_diyfp_t c_mk = __js_cached_power( w_p.e, _k );
+
+    js_diyfp_t W = __js_diyfp_multiply( __js_diyfp_normalize( v ), c_mk );
+    js_diyfp_t Wp = __js_diyfp_multiply( w_p, c_mk );
+    js_diyfp_t Wm = __js_diyfp_multiply( w_m, c_mk );
+
+    Wm.f++;
+    Wp.f--;
+
+    __js_grisu_digits( W, Wp, Wp.f - Wm.f, _buffer, _size, _k );
+}
+//////////////////////////////////////////////////////////////////////////
+static char * __js_write_exponent( int32_t _k, char * _buffer )
+{
+    if( _k < 0 )
+    {
+        *_buffer++ = '-';
+
+        _k = -_k;
+    }
+
+    if( _k >= 100 )
+    {
+        *_buffer++ = (char)('0' + _k / 100);
+
+        _k %= 100;
+
+        *_buffer++ = (char)('0' + _k / 10);
+        *_buffer++ = (char)('0' + _k % 10);
+    }
+    else if( _k >= 10 )
+    {
+        *_buffer++ = (char)('0' + _k / 10);
+        *_buffer++ = (char)('0' + _k % 10);
+    }
+    else
+    {
+        *_buffer++ = (char)('0' + _k);
+    }
+
+    return _buffer;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_move_digits( char * _dst, const char * _src, int32_t _size )
+{
+    if( _dst > _src )
+    {
+        for( int32_t index = _size; index != 0; --index )
+        {
+            _dst[index - 1] = _src[index - 1];
+        }
+    }
+    else
+    {
+        for( int32_t index = 0; index != _size; ++index )
+        {
+            _dst[index] = _src[index];
+        }
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+static void __js_round_digits( char * _buffer, int32_t * const _size, int32_t * const _k, int32_t _precision )
+{
+    // digits kept in front of the cut at _precision decimal places
+    int32_t keep = *_size + *_k + _precision;
+
+    if( keep >= *_size )
+    {
+        return;
+    }
+
+    if( keep < 0 || (keep == 0 && _buffer[0] < '5') )
+    {
+        _buffer[0] = '0';
+
+        *_size = 1;
+        *_k = 0;
+
+        return;
+    }
+
+    if( keep == 0 )
+    {
+        _buffer[0] = '1';
+
+        *_size = 1;
+        *_k = -_precision;
+
+        return;
+    }
+
+    int32_t k = *_k + *_size - keep;
+
+    if( _buffer[keep] >= '5' )
+    {
+        int32_t index = keep - 1;
+
+        while( index >= 0 && _buffer[index] == '9' )
+        {
+            --index;
+        }
+
+        if( index < 0 )
+        {
+            // 999 -> 1000
+            _buffer[0] = '1';
+
+            *_size = 1;
+            *_k = k + keep;
+
+            return;
+        }
+
+        ++_buffer[index];
+
+        *_size = index + 1;
+        *_k = k + keep - index - 1;
+
+        return;
+    }
+
+    int32_t size = keep;
+
+    while( size > 1 && _buffer[size - 1] == '0' )
+    {
+        --size;
+        ++k;
+    }
+
+    *_size = size;
+    *_k = k;
+}
+//////////////////////////////////////////////////////////////////////////
+static char * __js_prettify( char * _buffer, int32_t _size, int32_t _k )
+{
+    // 10^(kk-1) <= v < 10^kk
+    int32_t kk = _size + _k;
+
+    if( _k >= 0 && kk <= 21 )
+    {
+        // 1234e7 -> 12340000000.0
+        for( int32_t index = _size; index < kk; index++ )
+        {
+            _buffer[index] = '0';
+        }
+
+        _buffer[kk] = '.';
+        _buffer[kk + 1] = '0';
+
+        return _buffer + kk + 2;
+    }
+    else if( kk > 0 && kk <= 21 )
+    {
+        // 1234e-2 -> 12.34
+        __js_move_digits( _buffer + kk + 1, _buffer + kk, _size - kk );
+
+        _buffer[kk] = '.';
+
+        return _buffer + _size + 1;
+    }
+    else if( kk > -6 && kk <= 0 )
+    {
+        // 1234e-6 -> 0.001234
+        int32_t offset = 2 - kk;
+
+        __js_move_digits( _buffer + offset, _buffer, _size );
+
+        _buffer[0] = '0';
+        _buffer[1] = '.';
+
+        for( int32_t index = 2; index < offset; index++ )
+        {
+            _buffer[index] = '0';
+        }
+
+        return _buffer + _size + offset;
+    }
+    else if( _size == 1 )
+    {
+        // 1e30
+        _buffer[1] = 'e';
+
+        char * end = __js_write_exponent( kk - 1, _buffer + 2 );
+
+        return end;
+    }
+
+    // 1234e30 -> 1.234e33
+    __js_move_digits( _buffer + 2, _buffer + 1, _size - 1 );
+
+    _buffer[1] = '.';
+    _buffer[_size + 1] = 'e';
+
+    char * end = __js_write_exponent( kk - 1, _buffer + _size + 2 );
+
+    return end;
+}
+//////////////////////////////////////////////////////////////////////////
+js_size_t js_format_real( char * const _buffer, js_real_t _value, int32_t _precision )
+{
+    uint64_t u = __js_real_bits( _value );
+
+    if( (u & JS_REAL_EXPONENT_MASK) == JS_REAL_EXPONENT_MASK )
+    {
+        // JSON has no NaN or Infinity
+        _buffer[0] = 'n';
+        _buffer[1] = 'u';
+        _buffer[2] = 'l';
+        _buffer[3] = 'l';
+
+        return 4;
+    }
+
+    char * it = _buffer;
+
+    if( (u >> 63) != 0 )
+    {
+        *it++ = '-';
+
+        _value = -_value;
+    }
+
+    if( _value == 0.0 )
+    {
+        *it++ = '0';
+        *it++ = '.';
+        *it++ = '0';
+
+        return it - _buffer;
+    }
+
+    if( _precision <= 0 )
+    {
+        _precision = JS_REAL_MAX_DECIMAL_PLACES;
+    }
+
+    int32_t size;
+    int32_t k;
+    __js_grisu2( _value, it, &size, &k );
+
+    __js_round_digits( it, &size, &k, _precision );
+
+    char * end = __js_prettify( it, size, k );
+
+    return end - _buffer;
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#ifndef JSON_FORMAT_H_
+#define JSON_FORMAT_H_
+
+#include "json/json_config.h"
+
+#define JS_FORMAT_INTEGER_MAX_SIZE 20
+#define JS_FORMAT_REAL_MAX_SIZE 32
+
+js_size_t js_format_integer_size( js_integer_t _value );
+js_size_t js_format_integer( char * const _buffer, js_integer_t _value );
+js_size_t js_format_real( char * const _buffer, js_real_t _value, int32_t _precision );
+
+#endif
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include "json_string.h"
 
+#if JS_SIMD_SSE2_ENABLE
+#   include <emmintrin.h>
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 js_bool_t js_isspace( char c )
 {
@@ -161,7 +165,27 @@ js_bool_t js_strzcmp( js_string_t _s1, js_string_t _s2 )
         return JS_FALSE;
     }
 
-    for( js_size_t index = 0; index != _s1.size; ++index )
+    if( _s1.value == _s2.value )
+    {
+        return JS_TRUE;
+    }
+
+    js_size_t index = 0;
+
+#if JS_SIMD_SSE2_ENABLE
+    for( ; index + 16 <= _s1.size; index += 16 )
+    {
+        __m128i v1 = _mm_loadu_si128( (const __m128i *)(_s1.value + index) );
+        __m128i v2 = _mm_loadu_si128( (const __m128i *)(_s2.value + index) );
+
+        if( _mm_movemask_epi8( _mm_cmpeq_epi8( v1, v2 ) ) != 0xffff )
+        {
+            return JS_FALSE;
+        }
+    }
+#endif
+
+    for( ; index != _s1.size; ++index )
     {
         if( _s1.value[index] != _s2.value[index] )
         {
@@ -172,6 +196,19 @@ js_bool_t js_strzcmp( js_string_t _s1, js_string_t _s2 )
     return JS_TRUE;
 }
 //////////////////////////////////////////////////////////////////////////
+uint32_t js_strhash( js_string_t _value )
+{
+    uint32_t hash = 2166136261U;
+
+    for( js_size_t index = 0; index != _value.size; ++index )
+    {
+        hash ^= (uint8_t)_value.value[index];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+//////////////////////////////////////////////////////////////////////////
 #define JS_STRTOLL_INCREASE_EOF() ++s; if( s == _end ) { *_it = _in; return 0; }
 //////////////////////////////////////////////////////////////////////////
 int64_t js_strtoll( const char * _in, const char * _end, const char ** _it )
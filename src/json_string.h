@@ -14,6 +14,7 @@ const char * js_strstr( const char * _begin, const char * _end, const char * _st
 const char * js_strchr( const char * _begin, const char * _end, char _ch );
 js_bool_t js_strncmp( const char * _s1, const char * _s2, js_size_t _n );
 js_bool_t js_strzcmp( js_string_t _s1, js_string_t _s2 );
+uint32_t js_strhash( js_string_t _value );
 int64_t js_strtoll( const char * _in, const char * _end, const char ** _it );
 double js_strtod( const char * _in, const char * _end, const char ** _it );
 
@@ -0,0 +1,227 @@
+#include "json/json.h"
+#include "json/json_dump.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+typedef struct arena_stats_t
+{
+    js_size_t count;
+    js_size_t allocs;
+    js_size_t frees;
+} arena_stats_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    arena_stats_t * stats = (arena_stats_t *)ud;
+
+    ++stats->count;
+    ++stats->allocs;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    arena_stats_t * stats = (arena_stats_t *)ud;
+
+    --stats->count;
+    ++stats->frees;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __check( const js_element_t * _element, const char * _expected )
+{
+    static char dump_memory[65536];
+
+    js_buffer_t dump_buff;
+    js_make_buffer( dump_memory, sizeof( dump_memory ), &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_dump( _element, &dump_ctx );
+
+    if( strcmp( dump_memory, _expected ) != 0 )
+    {
+        printf( "arena mismatch:\n  dump: %s\n  expected: %s\n", dump_memory, _expected );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_element_t * __parse( js_allocator_t _allocator, js_flags_t _flags, const char * _data )
+{
+    js_element_t * element;
+    if( js_parse( _allocator, _flags, _data, strlen( _data ) + 1, &__failed, JS_NULLPTR, &element ) == JS_FAILURE )
+    {
+        return JS_NULLPTR;
+    }
+
+    return element;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __make_message( char * _buffer, js_size_t _fields, int _seed )
+{
+    char * it = _buffer;
+
+    *it++ = '{';
+
+    for( js_size_t index = 0; index != _fields; ++index )
+    {
+        it += sprintf( it, "%s\"f%03zu\":{\"v\":[%d,\"s%d\",100000,0.25]}", index == 0 ? "" : ",", index, (int)((index + _seed) % 100), _seed );
+    }
+
+    *it++ = '}';
+    *it = '\0';
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_arena( js_allocator_t _allocator, arena_stats_t * _stats )
+{
+    static char message[65536];
+    __make_message( message, 500, 0 );
+
+    _stats->allocs = 0;
+
+    js_element_t * document = __parse( _allocator, js_flag_arena | js_flag_node_pool, message );
+
+    js_size_t chunks = _stats->allocs;
+
+    if( chunks == 0 || chunks > 16 )
+    {
+        printf( "arena parse allocated %zu times\n", chunks );
+
+        return EXIT_FAILURE;
+    }
+
+    if( __check( document, message ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    for( int seed = 1; seed != 4; ++seed )
+    {
+        __make_message( message, 500, seed );
+
+        _stats->allocs = 0;
+
+        if( js_parse_into( document, message, strlen( message ) + 1, &__failed, JS_NULLPTR ) == JS_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+
+        if( _stats->allocs != 0 )
+        {
+            printf( "arena reset did not keep its chunks: %zu allocations\n", _stats->allocs );
+
+            return EXIT_FAILURE;
+        }
+
+        if( __check( document, message ) == EXIT_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    js_element_t * list = js_object_get( js_object_get( document, "f007" ), "v" );
+
+    js_array_remove( document, list, 1 );
+
+    if( js_array_push_string( document, list, "tail" ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    _stats->frees = 0;
+
+    js_free( document );
+
+    if( _stats->frees != chunks )
+    {
+        printf( "arena free released %zu blocks for %zu chunks\n", _stats->frees, chunks );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_clone( js_allocator_t _allocator )
+{
+    const char * json_base = "{\"a\":{\"b\":[1,\"two\",300000]},\"c\":\"d\"}";
+
+    js_element_t * base = __parse( _allocator, js_flag_none, json_base );
+
+    js_element_t * clone;
+    if( js_clone( _allocator, js_flag_arena, base, &clone ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * patch = __parse( _allocator, js_flag_none, "{\"a\":{\"b\":null,\"e\":true}}" );
+
+    if( js_patch_inplace( clone, patch ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __check( clone, "{\"a\":{\"e\":true},\"c\":\"d\"}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( patch );
+    js_free( clone );
+    js_free( base );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    arena_stats_t stats;
+    stats.count = 0;
+    stats.allocs = 0;
+    stats.frees = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    if( __test_arena( allocator, &stats ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_clone( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( stats.count != 0 )
+    {
+        printf( "arena leaked allocations: %zu\n", stats.count );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
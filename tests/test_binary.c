@@ -0,0 +1,278 @@
+#include "json/json.h"
+#include "json/json_dump.h"
+#include "json/json_binary.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    (void)ud;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    (void)ud;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct binary_output_t
+{
+    uint8_t memory[4096];
+    js_size_t size;
+} binary_output_t;
+//////////////////////////////////////////////////////////////////////////
+static void __binary_write( const void * _buffer, js_size_t _size, void * _ud )
+{
+    binary_output_t * output = (binary_output_t *)_ud;
+
+    if( output->size + _size > sizeof( output->memory ) )
+    {
+        return;
+    }
+
+    memcpy( output->memory + output->size, _buffer, _size );
+
+    output->size += _size;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __dump( const js_element_t * _element, char * _memory, js_size_t _capacity )
+{
+    js_buffer_t dump_buff;
+    js_make_buffer( _memory, _capacity, &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_dump( _element, &dump_ctx );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_binary( js_allocator_t _allocator, const js_element_t * _base, js_binary_flags_t _flags )
+{
+    binary_output_t output;
+    output.size = 0;
+
+    js_binary_ex_ctx_t binary_ctx;
+    js_make_binary_ex_ctx_default( _allocator, &__binary_write, &output, _flags, &binary_ctx );
+
+    js_binary_ex( _base, &binary_ctx );
+
+    binary_output_t staged;
+    staged.size = 0;
+
+    uint8_t stage[7];
+
+    js_binary_ex_ctx_t staged_ctx;
+    js_make_binary_ex_ctx_stage( _allocator, &__binary_write, &staged, _flags, stage, sizeof( stage ), &staged_ctx );
+
+    js_binary_ex( _base, &staged_ctx );
+
+    uint8_t direct[4096];
+
+    js_buffer_t direct_buffer;
+    js_make_buffer( direct, sizeof( direct ), &direct_buffer );
+
+    js_binary_ex_ctx_t direct_ctx;
+    js_make_binary_ex_ctx_buffer( _allocator, &direct_buffer, _flags, &direct_ctx );
+
+    if( js_binary_ex( _base, &direct_ctx ) == JS_FAILURE
+        || staged.size != output.size || memcmp( staged.memory, output.memory, output.size ) != 0
+        || js_get_buffer_size( &direct_buffer ) != output.size || memcmp( direct, output.memory, output.size ) != 0 )
+    {
+        printf( "binary staged output mismatch\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    if( _flags == js_binary_flag_none )
+    {
+        binary_output_t plain;
+        plain.size = 0;
+
+        js_binary_ctx_t plain_ctx;
+        plain_ctx.write = &__binary_write;
+        plain_ctx.ud = &plain;
+
+        js_binary( _base, &plain_ctx );
+
+        if( plain.size != output.size || memcmp( plain.memory, output.memory, output.size ) != 0 )
+        {
+            printf( "binary plain ctx output mismatch\n" );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    js_make_buffer( direct, output.size - 1, &direct_buffer );
+
+    if( js_binary_ex( _base, &direct_ctx ) == JS_SUCCESSFUL )
+    {
+        printf( "binary buffer overflow not reported\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * load;
+    if( js_binary_load( _allocator, js_flag_node_pool | js_flag_string_inplace, output.memory, output.size, &load ) == JS_FAILURE )
+    {
+        printf( "binary load failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    char base_dump[2048];
+    __dump( _base, base_dump, sizeof( base_dump ) );
+
+    char load_dump[2048];
+    __dump( load, load_dump, sizeof( load_dump ) );
+
+    js_free( load );
+
+    if( strcmp( base_dump, load_dump ) != 0 )
+    {
+        printf( "binary round trip mismatch\nbase: %s\nload: %s\n", base_dump, load_dump );
+
+        return EXIT_FAILURE;
+    }
+
+    js_binary_view_t view;
+    if( js_binary_view( output.memory, output.size, &view ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_binary_view_t big;
+    if( js_binary_view_object_get( &view, "big", &big ) == JS_FAILURE || js_binary_view_get_integer( &big ) != 1234567890123LL )
+    {
+        printf( "binary view [big] failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_binary_view_t list;
+    if( js_binary_view_object_get( &view, "list", &list ) == JS_FAILURE || js_binary_view_array_size( &list ) != 21 )
+    {
+        printf( "binary view [list] failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_binary_view_t list_item;
+    if( js_binary_view_array_get( &list, 12, &list_item ) == JS_FAILURE || js_binary_view_get_integer( &list_item ) != -1000 )
+    {
+        printf( "binary view [list item] failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_binary_view_t list_tail;
+    if( js_binary_view_array_get( &list, 16, &list_tail ) == JS_FAILURE || js_binary_view_get_real( &list_tail ) != 0.25 )
+    {
+        printf( "binary view [list tail] failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_binary_view_t list_min;
+    if( js_binary_view_array_get( &list, 18, &list_min ) == JS_FAILURE || js_binary_view_get_integer( &list_min ) != -9223372036854775807LL )
+    {
+        printf( "binary view [list min] failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_binary_view_t rows;
+    if( js_binary_view_object_get( &view, "rows", &rows ) == JS_FAILURE || js_binary_view_array_size( &rows ) != 3 )
+    {
+        printf( "binary view [rows] failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_binary_view_t nested;
+    js_binary_view_t nested_c;
+    js_binary_view_t nested_d;
+    if( js_binary_view_object_get( &view, "nested", &nested ) == JS_FAILURE
+        || js_binary_view_object_get( &nested, "c", &nested_c ) == JS_FAILURE
+        || js_binary_view_object_get( &nested_c, "d", &nested_d ) == JS_FAILURE )
+    {
+        printf( "binary view [nested] failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_string_t nested_d_value;
+    js_binary_view_get_string( &nested_d, &nested_d_value );
+
+    if( nested_d_value.size != 1 || nested_d_value.value[0] != 'e' || (const uint8_t *)nested_d_value.value < output.memory || (const uint8_t *)nested_d_value.value >= output.memory + output.size )
+    {
+        printf( "binary view [string] failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_binary_view_t missing;
+    if( js_binary_view_object_get( &view, "missing", &missing ) == JS_SUCCESSFUL )
+    {
+        printf( "binary view [missing] failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    char json_base[] = "{\"name\":\"binary\",\"age\":18,\"big\":1234567890123,\"neg\":-300,\"real\":2.5,\"flags\":[true,false,null],\"list\":[0,1,2,3,4,5,6,7,8,9,10,1000,-1000,{\"x\":1},[2],\"s\",0.25,1.0,-9223372036854775807,-1,65536],\"empty\":\"\",\"nested\":{\"a\":[],\"b\":{},\"c\":{\"d\":\"e\"}},\"k0\":0,\"k1\":1,\"k2\":2,\"k3\":3,\"k4\":4,\"k5\":5,\"k6\":6,\"k7\":7,\"rows\":[{\"id\":1,\"tag\":\"e\"},{\"id\":2,\"tag\":\"e\"},{\"id\":3,\"tag\":\"name\"}]}";
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, JS_NULLPTR, &allocator );
+
+    js_element_t * base;
+    if( js_parse( allocator, js_flag_node_pool, json_base, sizeof( json_base ), &__failed, JS_NULLPTR, &base ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    const js_binary_flags_t test_flags[] = {
+        js_binary_flag_none,
+        js_binary_flag_skippable,
+        js_binary_flag_table,
+        js_binary_flag_compact,
+        js_binary_flag_compact | js_binary_flag_table,
+        js_binary_flag_strings,
+        js_binary_flag_compact | js_binary_flag_table | js_binary_flag_string_values
+    };
+
+    for( js_size_t index = 0; index != sizeof( test_flags ) / sizeof( test_flags[0] ); ++index )
+    {
+        if( __test_binary( allocator, base, test_flags[index] ) == EXIT_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    js_free( base );
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
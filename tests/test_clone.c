@@ -0,0 +1,152 @@
+#include "json/json.h"
+#include "json/json_dump.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+typedef struct clone_stats_t
+{
+    js_size_t count;
+} clone_stats_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    clone_stats_t * stats = (clone_stats_t *)ud;
+
+    ++stats->count;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    clone_stats_t * stats = (clone_stats_t *)ud;
+
+    --stats->count;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __check( const js_element_t * _element, const char * _expected )
+{
+    char dump_memory[512];
+
+    js_buffer_t dump_buff;
+    js_make_buffer( dump_memory, sizeof( dump_memory ), &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_dump( _element, &dump_ctx );
+
+    if( strcmp( dump_memory, _expected ) != 0 )
+    {
+        printf( "clone mismatch:\n  dump: %s\n  expected: %s\n", dump_memory, _expected );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_element_t * __parse( js_allocator_t _allocator, js_flags_t _flags, const char * _data )
+{
+    js_element_t * element;
+    if( js_parse( _allocator, _flags, _data, strlen( _data ) + 1, &__failed, JS_NULLPTR, &element ) == JS_FAILURE )
+    {
+        return JS_NULLPTR;
+    }
+
+    return element;
+}
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+static int __test_compact( js_allocator_t _allocator, clone_stats_t * _stats, js_flags_t _flags )
+{
+    const char * json_base = "{\"name\":\"template\",\"id\":100000,\"ratio\":0.25,\"small\":3,\"flags\":[true,false,null],\"nested\":{\"list\":[1,2,{\"k\":\"value\"}],\"empty\":{}},\"odd\":\"abc\"}";
+
+    js_element_t * base = __parse( _allocator, js_flag_none, json_base );
+
+    js_size_t base_count = _stats->count;
+
+    js_element_t * clone;
+    if( js_clone( _allocator, _flags | js_flag_compact, base, &clone ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( _stats->count != base_count + 1 )
+    {
+        printf( "clone compact used %zu allocations\n", _stats->count - base_count );
+
+        return EXIT_FAILURE;
+    }
+
+    if( __check( clone, json_base ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * list = js_object_get( js_object_get( clone, "nested" ), "list" );
+
+    js_array_remove( clone, list, 0 );
+
+    if( js_array_push_string( clone, list, "grown" ) == JS_FAILURE || js_array_push_integer( clone, list, 1000000 ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __check( clone, "{\"name\":\"template\",\"id\":100000,\"ratio\":0.25,\"small\":3,\"flags\":[true,false,null],\"nested\":{\"list\":[2,{\"k\":\"value\"},\"grown\",1000000],\"empty\":{}},\"odd\":\"abc\"}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( clone );
+    js_free( base );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    clone_stats_t stats;
+    stats.count = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    if( __test_compact( allocator, &stats, js_flag_none ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_compact( allocator, &stats, js_flag_node_pool ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( stats.count != 0 )
+    {
+        printf( "clone leaked allocations: %zu\n", stats.count );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,830 @@
+#include "json/json.h"
+#include "json/json_dump.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    (void)ud;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    (void)ud;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_measure( js_allocator_t _allocator, const js_element_t * _base )
+{
+    char dump_memory[4096];
+
+    js_buffer_t dump_buff;
+    js_make_buffer( dump_memory, sizeof( dump_memory ), &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    if( js_dump( _base, &dump_ctx ) == JS_FAILURE )
+    {
+        printf( "dump failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_size_t size;
+    js_dump_measure( _base, &size );
+
+    if( size + 1 != js_get_buffer_size( &dump_buff ) )
+    {
+        printf( "dump measure mismatch: %zu != %zu\n", size, js_get_buffer_size( &dump_buff ) - 1 );
+
+        return EXIT_FAILURE;
+    }
+
+    char * alloc_memory;
+    js_size_t alloc_size;
+    if( js_dump_alloc( _base, _allocator, &alloc_memory, &alloc_size ) == JS_FAILURE )
+    {
+        printf( "dump alloc failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    int result = (alloc_size == size && strcmp( alloc_memory, dump_memory ) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    _allocator.free( alloc_memory, _allocator.ud );
+
+    if( result == EXIT_FAILURE )
+    {
+        printf( "dump alloc mismatch\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_make_buffer( dump_memory, size, &dump_buff );
+
+    if( js_dump( _base, &dump_ctx ) == JS_SUCCESSFUL )
+    {
+        printf( "dump overflow not reported\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_size_t __reference_escape( const char * _value, js_size_t _size, char * _buffer )
+{
+    char * it = _buffer;
+
+    for( js_size_t index = 0; index != _size; ++index )
+    {
+        unsigned char c = (unsigned char)_value[index];
+
+        switch( c )
+        {
+        case '\"': *it++ = '\\'; *it++ = '\"'; break;
+        case '\\': *it++ = '\\'; *it++ = '\\'; break;
+        case '\b': *it++ = '\\'; *it++ = 'b'; break;
+        case '\f': *it++ = '\\'; *it++ = 'f'; break;
+        case '\n': *it++ = '\\'; *it++ = 'n'; break;
+        case '\r': *it++ = '\\'; *it++ = 'r'; break;
+        case '\t': *it++ = '\\'; *it++ = 't'; break;
+        default:
+            if( c < 0x20 )
+            {
+                it += sprintf( it, "\\u%04x", c );
+            }
+            else
+            {
+                *it++ = (char)c;
+            }
+        }
+    }
+
+    return it - _buffer;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_escape( void )
+{
+    char value[256];
+
+    for( js_size_t size = 0; size != 80; ++size )
+    {
+        for( js_size_t position = 0; position <= size; ++position )
+        {
+            for( js_size_t index = 0; index != size; ++index )
+            {
+                value[index] = (char)('a' + index % 26);
+            }
+
+            if( position != size )
+            {
+                static const char specials[] = {'\"', '\\', '\n', '\t', '\x01', '\x1f', '\x7f', '\x80', '\xff'};
+
+                value[position] = specials[(size + position) % sizeof( specials )];
+            }
+
+            char expected[1024];
+            js_size_t expected_size = __reference_escape( value, size, expected );
+
+            char buffer[1024];
+            js_size_t buffer_size;
+
+            js_string_t str = {value, size};
+            if( js_dump_string( str, buffer, sizeof( buffer ), &buffer_size ) == JS_FAILURE
+                || buffer_size != expected_size || memcmp( buffer, expected, expected_size ) != 0 )
+            {
+                printf( "dump string escape mismatch size: %zu position: %zu\n", size, position );
+
+                return EXIT_FAILURE;
+            }
+
+            if( expected_size != 0 && js_dump_string( str, buffer, expected_size - 1, &buffer_size ) == JS_SUCCESSFUL )
+            {
+                printf( "dump string overflow not reported\n" );
+
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __dump_real( js_allocator_t _allocator, double _value, int32_t _precision, char * _memory, js_size_t _capacity )
+{
+    js_element_t * document;
+    if( js_create( _allocator, js_flag_none, &document ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_string_t key = {"r", 1};
+    js_object_add_field_real( document, document, key, _value );
+
+    js_buffer_t dump_buff;
+    js_make_buffer( _memory, _capacity, &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+    js_set_dump_ctx_precision( _precision, &dump_ctx );
+
+    js_result_t result = js_dump( document, &dump_ctx );
+
+    js_size_t size;
+    js_dump_measure( document, &size );
+
+    js_free( document );
+
+    if( result == JS_FAILURE || (_precision == 0 && size + 1 != js_get_buffer_size( &dump_buff )) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_real( js_allocator_t _allocator )
+{
+    static const struct
+    {
+        double value;
+        int32_t precision;
+        const char * expected;
+    } cases[] = {
+        {0.0, 0, "{\"r\":0.0}"},
+        {1.0, 0, "{\"r\":1.0}"},
+        {0.25, 0, "{\"r\":0.25}"},
+        {-0.5, 0, "{\"r\":-0.5}"},
+        {1e-9, 0, "{\"r\":1e-9}"},
+        {1.5e-7, 0, "{\"r\":1.5e-7}"},
+        {0.000001, 0, "{\"r\":0.000001}"},
+        {123.456, 0, "{\"r\":123.456}"},
+        {1e21, 0, "{\"r\":1e21}"},
+        {1e30, 0, "{\"r\":1e30}"},
+        {-1.2345e-300, 0, "{\"r\":-1.2345e-300}"},
+        {0.1, 0, "{\"r\":0.1}"},
+        {5e-324, 0, "{\"r\":5e-324}"},
+        {1.7976931348623157e308, 0, "{\"r\":1.7976931348623157e308}"},
+        {3.14159, 3, "{\"r\":3.142}"},
+        {0.0001, 3, "{\"r\":0.0}"},
+        {0.0005, 3, "{\"r\":0.001}"},
+        {9.9996, 3, "{\"r\":10.0}"},
+        {-0.0996, 2, "{\"r\":-0.1}"},
+        {2.5004, 3, "{\"r\":2.5}"},
+        {1.5e-7, 3, "{\"r\":0.0}"},
+    };
+
+    for( js_size_t index = 0; index != sizeof( cases ) / sizeof( cases[0] ); ++index )
+    {
+        char memory[64];
+        if( __dump_real( _allocator, cases[index].value, cases[index].precision, memory, sizeof( memory ) ) == EXIT_FAILURE
+            || strcmp( memory, cases[index].expected ) != 0 )
+        {
+            printf( "dump real mismatch: %s != %s\n", memory, cases[index].expected );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    for( uint32_t iteration = 0; iteration != 100000; ++iteration )
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        double value;
+        memcpy( &value, &seed, sizeof( value ) );
+
+        if( value != value || value - value != 0.0 )
+        {
+            continue;
+        }
+
+        char memory[64];
+        if( __dump_real( _allocator, value, 0, memory, sizeof( memory ) ) == EXIT_FAILURE )
+        {
+            printf( "dump real failed\n" );
+
+            return EXIT_FAILURE;
+        }
+
+        double load = strtod( memory + 5, JS_NULLPTR );
+
+        if( memcmp( &load, &value, sizeof( value ) ) != 0 )
+        {
+            printf( "dump real round trip mismatch: %s\n", memory );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_integer( js_allocator_t _allocator )
+{
+    js_element_t * document;
+    if( js_create( _allocator, js_flag_none, &document ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * integers;
+    js_string_t integers_key = {"i", 1};
+    js_object_add_field_array( document, document, integers_key, &integers );
+
+    js_element_t * mixed;
+    js_string_t mixed_key = {"m", 1};
+    js_object_add_field_array( document, document, mixed_key, &mixed );
+
+    char expected[65536];
+    char * it_integers = expected + sprintf( expected, "{\"i\":[" );
+
+    char mixed_expected[256];
+    char * it_mixed = mixed_expected + sprintf( mixed_expected, "\"m\":[" );
+
+    const js_integer_t specials[] = {0, 1, -1, 9, 10, -10, 99, 100, 999, 1000, 65535, -65536, INT64_MAX, INT64_MIN, INT64_MIN + 1};
+
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+
+    for( uint32_t index = 0; index != 2000; ++index )
+    {
+        js_integer_t value;
+
+        if( index < sizeof( specials ) / sizeof( specials[0] ) )
+        {
+            value = specials[index];
+
+            js_array_push_integer( document, mixed, value );
+            js_array_push_null( document, mixed );
+
+            it_mixed += sprintf( it_mixed, "%s%lld,null", index == 0 ? "" : ",", (long long)value );
+        }
+        else
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+
+            value = (js_integer_t)(seed >> (seed % 64));
+        }
+
+        js_array_push_integer( document, integers, value );
+
+        it_integers += sprintf( it_integers, "%s%lld", index == 0 ? "" : ",", (long long)value );
+    }
+
+    sprintf( it_integers, "],%s]}", mixed_expected );
+
+    char * dump_memory;
+    js_size_t dump_size;
+    js_result_t result = js_dump_alloc( document, _allocator, &dump_memory, &dump_size );
+
+    js_free( document );
+
+    if( result == JS_FAILURE )
+    {
+        printf( "dump integer failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    int test = (dump_size == strlen( expected ) && strcmp( dump_memory, expected ) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    if( test == EXIT_FAILURE )
+    {
+        printf( "dump integer mismatch\n%s\n%s\n", dump_memory, expected );
+    }
+
+    _allocator.free( dump_memory, _allocator.ud );
+
+    return test;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_writer( js_allocator_t _allocator )
+{
+    char base_json[] = "{\"x\":1,\"y\":[true]}";
+
+    js_element_t * base;
+    if( js_parse( _allocator, js_flag_none, base_json, sizeof( base_json ), &__failed, JS_NULLPTR, &base ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    char memory[256];
+
+    js_buffer_t dump_buff;
+    js_make_buffer( memory, sizeof( memory ), &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_writer_t writer;
+    js_make_writer( &dump_ctx, &writer );
+
+    js_result_t result = JS_SUCCESSFUL;
+
+    result |= js_write_object_begin( &writer );
+    result |= js_write_key( &writer, "id" );
+    result |= js_write_integer( &writer, -42 );
+    result |= js_write_key( &writer, "name" );
+    result |= js_write_string( &writer, "a\"b" );
+    result |= js_write_key( &writer, "list" );
+    result |= js_write_array_begin( &writer );
+    result |= js_write_null( &writer );
+    result |= js_write_boolean( &writer, JS_TRUE );
+    result |= js_write_real( &writer, 0.5 );
+    result |= js_write_array_begin( &writer );
+    result |= js_write_array_end( &writer );
+    result |= js_write_object_begin( &writer );
+    result |= js_write_object_end( &writer );
+    result |= js_write_array_end( &writer );
+    result |= js_write_key( &writer, "base" );
+    result |= js_write_element( &writer, base );
+    result |= js_write_object_end( &writer );
+    result |= js_write_finish( &writer );
+
+    js_free( base );
+
+    const char * expected = "{\"id\":-42,\"name\":\"a\\\"b\",\"list\":[null,true,0.5,[],{}],\"base\":{\"x\":1,\"y\":[true]}}";
+
+    if( result == JS_FAILURE || strcmp( memory, expected ) != 0 )
+    {
+        printf( "writer mismatch: %s\n", memory );
+
+        return EXIT_FAILURE;
+    }
+
+    js_make_buffer( memory, sizeof( memory ), &dump_buff );
+    js_make_writer( &dump_ctx, &writer );
+
+    if( js_write_key( &writer, "root" ) == JS_SUCCESSFUL )
+    {
+        printf( "writer accepted key outside object\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_write_object_begin( &writer );
+
+    if( js_write_integer( &writer, 1 ) == JS_SUCCESSFUL || js_write_array_end( &writer ) == JS_SUCCESSFUL || js_write_finish( &writer ) == JS_SUCCESSFUL )
+    {
+        printf( "writer accepted malformed sequence\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    char real_json[] = "{\"pi\":[3.14159]}";
+
+    js_element_t * real;
+    if( js_parse( _allocator, js_flag_none, real_json, sizeof( real_json ), &__failed, JS_NULLPTR, &real ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_make_buffer( memory, sizeof( memory ), &dump_buff );
+    js_set_dump_ctx_precision( 3, &dump_ctx );
+    js_make_writer( &dump_ctx, &writer );
+
+    result = JS_SUCCESSFUL;
+
+    result |= js_write_array_begin( &writer );
+    result |= js_write_real( &writer, 3.14159 );
+    result |= js_write_element( &writer, real );
+    result |= js_write_array_end( &writer );
+    result |= js_write_finish( &writer );
+
+    js_free( real );
+
+    if( result == JS_FAILURE || strcmp( memory, "[3.142,{\"pi\":[3.142]}]" ) != 0 )
+    {
+        printf( "writer precision mismatch: %s\n", memory );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __parallel_run( js_dump_chunk_t * _chunks, js_size_t _count, void * _ud )
+{
+    js_size_t * calls = (js_size_t *)_ud;
+
+    for( js_size_t index = _count; index != 0; --index )
+    {
+        js_dump_chunk( _chunks + index - 1 );
+    }
+
+    ++*calls;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_parallel_document( js_allocator_t _allocator, const js_element_t * _document )
+{
+    char * expected;
+    js_size_t expected_size;
+    if( js_dump_alloc( _document, _allocator, &expected, &expected_size ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_size_t calls = 0;
+
+    js_dump_chunk_t * chunks;
+    js_size_t count;
+    if( js_dump_parallel( _document, _allocator, 4, &__parallel_run, &calls, &chunks, &count ) == JS_FAILURE || calls != 1 )
+    {
+        printf( "dump parallel failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    char * memory = (char *)malloc( expected_size + 1 );
+
+    js_buffer_t dump_buff;
+    js_make_buffer( memory, expected_size + 1, &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_result_t result = js_dump_chunks_concat( chunks, count, &dump_ctx );
+
+    js_dump_chunks_free( _allocator, chunks, count );
+
+    int test = (result == JS_SUCCESSFUL && strcmp( memory, expected ) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    if( test == EXIT_FAILURE )
+    {
+        printf( "dump parallel mismatch (%zu chunks)\n", count );
+    }
+
+    free( memory );
+    _allocator.free( expected, _allocator.ud );
+
+    return test;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_parallel( js_allocator_t _allocator )
+{
+    js_element_t * document;
+    if( js_create( _allocator, js_flag_node_pool, &document ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_parallel_document( _allocator, document ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_string_t head_key = {"head", 4};
+    js_object_add_field_integer( document, document, head_key, 1 );
+
+    js_element_t * list;
+    js_string_t list_key = {"list", 4};
+    js_object_add_field_array( document, document, list_key, &list );
+
+    for( js_integer_t index = 0; index != 10000; ++index )
+    {
+        if( index % 7 == 0 )
+        {
+            js_array_push_string( document, list, "seven" );
+        }
+        else
+        {
+            js_array_push_integer( document, list, index * 31 );
+        }
+    }
+
+    js_string_t middle_key = {"middle", 6};
+    js_object_add_field_string( document, document, middle_key, "m" );
+
+    js_element_t * map;
+    js_string_t map_key = {"map", 3};
+    js_object_add_field_object( document, document, map_key, &map );
+
+    char key_memory[3000][8];
+
+    for( js_size_t index = 0; index != 3000; ++index )
+    {
+        js_size_t key_size = (js_size_t)sprintf( key_memory[index], "k%zu", index );
+
+        js_string_t key = {key_memory[index], key_size};
+        js_object_add_field_real( document, map, key, (double)index * 0.5 );
+    }
+
+    js_string_t tail_key = {"tail", 4};
+    js_object_add_field_null( document, document, tail_key );
+
+    int test = __test_parallel_document( _allocator, document );
+
+    js_free( document );
+
+    return test;
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct dump_plain_t
+{
+    char memory[512];
+    js_size_t size;
+} dump_plain_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __plain_buffer( js_size_t _size, void * _ud )
+{
+    dump_plain_t * plain = (dump_plain_t *)_ud;
+
+    if( plain->size + _size > sizeof( plain->memory ) )
+    {
+        return JS_NULLPTR;
+    }
+
+    void * buffer = plain->memory + plain->size;
+
+    plain->size += _size;
+
+    return buffer;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_iovec( js_allocator_t _allocator )
+{
+    char json_base[] = "{\"short\":\"abc\",\"blob\":\"0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz\",\"list\":[1,2.5,\"0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz\"]}";
+
+    js_element_t * base;
+    if( js_parse( _allocator, js_flag_string_inplace, json_base, sizeof( json_base ), &__failed, JS_NULLPTR, &base ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    char expected[512];
+
+    js_buffer_t dump_buff;
+    js_make_buffer( expected, sizeof( expected ), &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_dump( base, &dump_ctx );
+
+    dump_plain_t plain;
+    plain.size = 0;
+
+    js_dump_ctx_t plain_ctx = {&__plain_buffer, &plain};
+
+    if( js_dump( base, &plain_ctx ) == JS_FAILURE || strcmp( plain.memory, expected ) != 0 )
+    {
+        printf( "dump positional ctx mismatch\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    char scratch[128];
+    js_iovec_t iovecs[16];
+    js_size_t iovec_count;
+    if( js_dump_iovec( base, scratch, sizeof( scratch ), iovecs, 16, &iovec_count ) == JS_FAILURE )
+    {
+        printf( "dump iovec failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    char gather[512];
+    js_size_t gather_size = 0;
+    js_size_t references = 0;
+
+    for( js_size_t index = 0; index != iovec_count; ++index )
+    {
+        const char * iovec_base = (const char *)iovecs[index].base;
+
+        if( iovec_base >= json_base && iovec_base < json_base + sizeof( json_base ) )
+        {
+            ++references;
+        }
+
+        memcpy( gather + gather_size, iovec_base, iovecs[index].size );
+        gather_size += iovecs[index].size;
+    }
+
+    gather[gather_size] = '\0';
+
+    int test = (references == 2 && strcmp( gather, expected ) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    if( test == EXIT_FAILURE )
+    {
+        printf( "dump iovec mismatch (%zu references): %s\n", references, gather );
+    }
+
+    if( js_dump_iovec( base, scratch, 16, iovecs, 16, &iovec_count ) == JS_SUCCESSFUL
+        || js_dump_iovec( base, scratch, sizeof( scratch ), iovecs, 2, &iovec_count ) == JS_SUCCESSFUL )
+    {
+        printf( "dump iovec overflow not reported\n" );
+
+        test = EXIT_FAILURE;
+    }
+
+    js_free( base );
+
+    return test;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __dump_source( const js_element_t * _element, char * _memory, js_size_t _capacity )
+{
+    js_buffer_t dump_buff;
+    js_make_buffer( _memory, _capacity, &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    if( js_dump( _element, &dump_ctx ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_size_t size;
+    js_dump_measure( _element, &size );
+
+    if( size + 1 != js_get_buffer_size( &dump_buff ) )
+    {
+        printf( "dump source measure mismatch: %zu != %zu\n", size, js_get_buffer_size( &dump_buff ) - 1 );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_source( js_allocator_t _allocator )
+{
+    char json_base[] = "{ \"keep\" : { \"a\" : [ 1, 2 ] },\n  \"edit\" : { \"b\" : [ 3 ], \"c\" : 1.50 } }";
+
+    js_element_t * base;
+    if( js_parse( _allocator, js_flag_source_span, json_base, sizeof( json_base ), &__failed, JS_NULLPTR, &base ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    char dump_memory[256];
+
+    if( __dump_source( base, dump_memory, sizeof( dump_memory ) ) == EXIT_FAILURE || strcmp( dump_memory, json_base ) != 0 )
+    {
+        printf( "dump source passthrough mismatch: %s\n", dump_memory );
+
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * edit = js_object_get( base, "edit" );
+    js_element_t * edit_b = js_object_get( edit, "b" );
+
+    if( js_array_push_integer( base, edit_b, 4 ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_string_t source;
+    if( js_get_source( base, &source ) == JS_TRUE || js_get_source( edit, &source ) == JS_TRUE || js_get_source( js_object_get( base, "keep" ), &source ) == JS_FALSE )
+    {
+        printf( "dump source dirty propagation failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    const char * expected = "{\"keep\":{ \"a\" : [ 1, 2 ] },\"edit\":{\"b\":[3,4],\"c\":1.5}}";
+
+    if( __dump_source( base, dump_memory, sizeof( dump_memory ) ) == EXIT_FAILURE || strcmp( dump_memory, expected ) != 0 )
+    {
+        printf( "dump source dirty mismatch: %s\n", dump_memory );
+
+        return EXIT_FAILURE;
+    }
+
+    js_free( base );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    char json_base[] = "{\"name\":\"dump\",\"age\":18,\"big\":1234567890123,\"neg\":-300,\"real\":2.5,\"flags\":[true,false,null],\"list\":[0,1,-1,1000,{\"x\":1},[2],\"s\",-9223372036854775807],\"empty\":\"\",\"nested\":{\"a\":[],\"b\":{},\"c\":{\"d\":\"e\"}}}";
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, JS_NULLPTR, &allocator );
+
+    js_element_t * base;
+    if( js_parse( allocator, js_flag_none, json_base, sizeof( json_base ), &__failed, JS_NULLPTR, &base ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_string_t quote_key = {"quote", 5};
+    if( js_object_add_field_string( base, base, quote_key, "a\"b\\c" ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_measure( allocator, base ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( base );
+
+    if( __test_escape() == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_real( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_integer( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_writer( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_parallel( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_iovec( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_source( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include "json/json.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    (void)ud;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    (void)ud;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static js_element_t * __parse( js_allocator_t _allocator, js_flags_t _flags, const char * _data )
+{
+    js_element_t * element;
+    if( js_parse( _allocator, _flags, _data, strlen( _data ) + 1, &__failed, JS_NULLPTR, &element ) == JS_FAILURE )
+    {
+        return JS_NULLPTR;
+    }
+
+    return element;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_equal_flags( js_allocator_t _allocator, js_flags_t _flags, const char * _a, const char * _b, js_bool_t _equal )
+{
+    js_element_t * a = __parse( _allocator, _flags, _a );
+    js_element_t * b = __parse( _allocator, _flags, _b );
+
+    if( a == JS_NULLPTR || b == JS_NULLPTR )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_bool_t equal = js_equal( _allocator, a, b );
+    js_bool_t equal_hash = js_hash( a ) == js_hash( b );
+
+    js_free( a );
+    js_free( b );
+
+    if( equal != _equal || (equal == JS_TRUE && equal_hash == JS_FALSE) )
+    {
+        printf( "equal mismatch: %s %s -> %u (hash %u, flags %u)\n", _a, _b, equal, equal_hash, _flags );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_equal( js_allocator_t _allocator, const char * _a, const char * _b, js_bool_t _equal )
+{
+    if( __test_equal_flags( _allocator, js_flag_node_pool, _a, _b, _equal ) == EXIT_FAILURE
+        || __test_equal_flags( _allocator, js_flag_node_pool | js_flag_hash_cache, _a, _b, _equal ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_invalidate( js_allocator_t _allocator )
+{
+    js_element_t * a = __parse( _allocator, js_flag_node_pool | js_flag_hash_cache, "{\"config\":{\"list\":[1,2],\"name\":\"0123456789abcdefghijklmnopqrstuvwxyz\"},\"version\":1}" );
+    js_element_t * b = __parse( _allocator, js_flag_node_pool | js_flag_hash_cache, "{\"version\":1,\"config\":{\"name\":\"0123456789abcdefghijklmnopqrstuvwxyz\",\"list\":[1,2,3]}}" );
+
+    if( a == JS_NULLPTR || b == JS_NULLPTR )
+    {
+        return EXIT_FAILURE;
+    }
+
+    int test = EXIT_SUCCESS;
+
+    if( js_equal( _allocator, a, b ) == JS_TRUE )
+    {
+        test = EXIT_FAILURE;
+    }
+
+    js_element_t * list = js_object_get( js_object_get( a, "config" ), "list" );
+
+    js_hash_t hash = js_hash( a );
+
+    js_array_push_integer( a, list, 3 );
+
+    if( js_hash( a ) == hash || js_equal( _allocator, a, b ) == JS_FALSE || js_hash( a ) != js_hash( b ) )
+    {
+        test = EXIT_FAILURE;
+    }
+
+    js_array_remove( a, list, 0 );
+
+    if( js_equal( _allocator, a, b ) == JS_TRUE )
+    {
+        test = EXIT_FAILURE;
+    }
+
+    js_free( a );
+    js_free( b );
+
+    if( test == EXIT_FAILURE )
+    {
+        printf( "equal invalidate failed\n" );
+    }
+
+    return test;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __make_object( char * _memory, js_size_t _count, js_bool_t _reverse, js_size_t _value )
+{
+    char * it = _memory;
+
+    *it++ = '{';
+
+    for( js_size_t index = 0; index != _count; ++index )
+    {
+        js_size_t key = _reverse == JS_TRUE ? _count - index - 1 : index;
+
+        it += sprintf( it, "%s\"k%zu\":[%zu]", index == 0 ? "" : ",", key, key == _count / 2 ? _value : key );
+    }
+
+    *it++ = '}';
+    *it = '\0';
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_reordered( js_allocator_t _allocator )
+{
+    char a[2048];
+    char b[2048];
+    char c[2048];
+
+    __make_object( a, 100, JS_FALSE, 50 );
+    __make_object( b, 100, JS_TRUE, 50 );
+    __make_object( c, 100, JS_TRUE, 51 );
+
+    if( __test_equal( _allocator, a, b, JS_TRUE ) == EXIT_FAILURE
+        || __test_equal( _allocator, a, c, JS_FALSE ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, JS_NULLPTR, &allocator );
+
+    if( __test_equal( allocator, "{\"a\":1,\"b\":[true,null,2.5,\"s\"],\"c\":{}}", "{\"c\":{},\"a\":1,\"b\":[true,null,2.5,\"s\"]}", JS_TRUE ) == EXIT_FAILURE
+        || __test_equal( allocator, "{\"a\":[1,2]}", "{\"a\":[2,1]}", JS_FALSE ) == EXIT_FAILURE
+        || __test_equal( allocator, "{\"a\":1}", "{\"a\":1.0}", JS_FALSE ) == EXIT_FAILURE
+        || __test_equal( allocator, "{\"a\":\"0123456789abcdefghij\"}", "{\"a\":\"0123456789abcdefghiJ\"}", JS_FALSE ) == EXIT_FAILURE
+        || __test_equal( allocator, "{\"a\":{\"b\":1}}", "{\"a\":{\"b\":1,\"c\":2}}", JS_FALSE ) == EXIT_FAILURE
+        || __test_equal( allocator, "{\"a\":1,\"b\":2}", "{\"a\":2,\"b\":1}", JS_FALSE ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_reordered( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_invalidate( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
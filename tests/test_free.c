@@ -0,0 +1,202 @@
+#include "json/json.h"
+#include "json/json_dump.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+typedef struct free_stats_t
+{
+    js_size_t count;
+    js_size_t allocs;
+    js_size_t frees;
+} free_stats_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    free_stats_t * stats = (free_stats_t *)ud;
+
+    ++stats->count;
+    ++stats->allocs;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    free_stats_t * stats = (free_stats_t *)ud;
+
+    --stats->count;
+    ++stats->frees;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __check( const js_element_t * _element, const char * _expected )
+{
+    char dump_memory[512];
+
+    js_buffer_t dump_buff;
+    js_make_buffer( dump_memory, sizeof( dump_memory ), &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_dump( _element, &dump_ctx );
+
+    if( strcmp( dump_memory, _expected ) != 0 )
+    {
+        printf( "free mismatch:\n  dump: %s\n  expected: %s\n", dump_memory, _expected );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_element_t * __parse( js_allocator_t _allocator, js_flags_t _flags, const char * _data )
+{
+    js_element_t * element;
+    if( js_parse( _allocator, _flags, _data, strlen( _data ) + 1, &__failed, JS_NULLPTR, &element ) == JS_FAILURE )
+    {
+        return JS_NULLPTR;
+    }
+
+    return element;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __drain( js_element_t * _document, free_stats_t * _stats, js_size_t _budget )
+{
+    js_size_t calls = 0;
+
+    for( ;; )
+    {
+        ++calls;
+
+        _stats->frees = 0;
+
+        js_bool_t remains = js_free_incremental( _document, _budget );
+
+        if( remains == JS_FALSE )
+        {
+            break;
+        }
+
+        if( _stats->frees > _budget * 4 )
+        {
+            printf( "free step released %zu blocks for budget %zu\n", _stats->frees, _budget );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    if( calls < 2 )
+    {
+        printf( "free incremental finished in one call\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_incremental( js_allocator_t _allocator, free_stats_t * _stats, js_flags_t _flags )
+{
+    const char * json_base = "{\"a\":{\"b\":[1,\"two\",300000,[[],{}],{\"c\":0.75}]},\"d\":\"e\",\"f\":[{\"g\":[1,2,3]}],\"h\":{}}";
+
+    js_element_t * document = __parse( _allocator, _flags, json_base );
+
+    if( __drain( document, _stats, 2 ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_shared( js_allocator_t _allocator, free_stats_t * _stats )
+{
+    const char * json_base = "{\"a\":{\"b\":[1,2,{\"c\":\"d\"}]},\"e\":[[1],[2]]}";
+
+    js_element_t * base = __parse( _allocator, js_flag_shared, json_base );
+
+    js_element_t * clone;
+    if( js_clone( _allocator, js_flag_shared, base, &clone ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __drain( base, _stats, 1 ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __check( clone, json_base ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * list = js_object_edit( clone, js_object_edit( clone, clone, "a" ), "b" );
+
+    if( list == JS_NULLPTR || js_array_push_integer( clone, list, 3 ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __drain( clone, _stats, 1 ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    free_stats_t stats;
+    stats.count = 0;
+    stats.allocs = 0;
+    stats.frees = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    if( __test_incremental( allocator, &stats, js_flag_none ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_incremental( allocator, &stats, js_flag_node_pool ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_shared( allocator, &stats ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( stats.count != 0 )
+    {
+        printf( "free leaked allocations: %zu\n", stats.count );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
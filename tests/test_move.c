@@ -0,0 +1,251 @@
+#include "json/json.h"
+#include "json/json_dump.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+typedef struct move_stats_t
+{
+    js_size_t count;
+} move_stats_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    move_stats_t * stats = (move_stats_t *)ud;
+
+    ++stats->count;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    move_stats_t * stats = (move_stats_t *)ud;
+
+    --stats->count;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __check( const js_element_t * _element, const char * _expected )
+{
+    char dump_memory[512];
+
+    js_buffer_t dump_buff;
+    js_make_buffer( dump_memory, sizeof( dump_memory ), &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_dump( _element, &dump_ctx );
+
+    if( strcmp( dump_memory, _expected ) != 0 )
+    {
+        printf( "move mismatch:\n  dump: %s\n  expected: %s\n", dump_memory, _expected );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_element_t * __parse( js_allocator_t _allocator, js_flags_t _flags, const char * _data )
+{
+    js_element_t * element;
+    if( js_parse( _allocator, _flags, _data, strlen( _data ) + 1, &__failed, JS_NULLPTR, &element ) == JS_FAILURE )
+    {
+        return JS_NULLPTR;
+    }
+
+    return element;
+}
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+static int __test_relink( js_allocator_t _allocator )
+{
+    js_element_t * from = __parse( _allocator, js_flag_none, "{\"keep\":1,\"tree\":{\"list\":[1,2,3],\"name\":\"n\"},\"tail\":[{\"x\":1},2]}" );
+    js_element_t * to = __parse( _allocator, js_flag_none, "{\"a\":[]}" );
+
+    js_element_t * tree = js_object_get( from, "tree" );
+    js_element_t * list = js_object_get( tree, "list" );
+
+    js_string_t moved_key = {"moved", 5};
+
+    if( js_object_move( to, to, moved_key, from, from, "tree" ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( js_object_get( to, "moved" ) != tree || js_object_get( tree, "list" ) != list )
+    {
+        printf( "move copied a relinkable subtree\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * tail = js_object_get( from, "tail" );
+    js_element_t * item = js_array_detach( from, tail, 0 );
+
+    if( item == JS_NULLPTR || js_array_attach( to, js_object_get( to, "a" ), from, item ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( js_array_detach( from, tail, 5 ) != JS_NULLPTR || js_object_detach( from, from, "missing" ) != JS_NULLPTR )
+    {
+        printf( "move detached a missing value\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * last = js_array_detach( from, tail, 0 );
+
+    js_discard( from, last );
+
+    if( js_array_push_integer( from, tail, 7 ) == JS_FAILURE || js_array_push_integer( to, list, 4 ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __check( from, "{\"keep\":1,\"tail\":[7]}" ) == EXIT_FAILURE
+        || __check( to, "{\"a\":[{\"x\":1}],\"moved\":{\"list\":[1,2,3,4],\"name\":\"n\"}}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( from );
+    js_free( to );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_copy( js_allocator_t _allocator, js_allocator_t _other, js_flags_t _from_flags, js_flags_t _to_flags )
+{
+    js_element_t * from = __parse( _allocator, _from_flags, "{\"tree\":{\"list\":[1,2,3],\"name\":\"n\"},\"rest\":[4]}" );
+    js_element_t * to = __parse( _other, _to_flags, "{}" );
+
+    js_element_t * tree = js_object_get( from, "tree" );
+
+    js_string_t moved_key = {"moved", 5};
+
+    if( js_object_move( to, to, moved_key, from, from, "tree" ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( js_object_get( to, "moved" ) == tree )
+    {
+        printf( "move relinked across incompatible documents\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    if( __check( from, "{\"rest\":[4]}" ) == EXIT_FAILURE
+        || __check( to, "{\"moved\":{\"list\":[1,2,3],\"name\":\"n\"}}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( from );
+    js_free( to );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_refused( js_allocator_t _allocator )
+{
+    js_element_t * from = __parse( _allocator, js_flag_shared, "{\"tree\":[1,2]}" );
+    js_element_t * to = __parse( _allocator, js_flag_shared, "{\"a\":{\"b\":1}}" );
+
+    js_element_t * snapshot;
+    if( js_clone( _allocator, js_flag_shared, to, &snapshot ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_string_t moved_key = {"moved", 5};
+
+    if( js_object_move( to, js_object_get( to, "a" ), moved_key, from, from, "tree" ) == JS_SUCCESSFUL )
+    {
+        printf( "move into a shared container was not refused\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    if( __check( from, "{\"tree\":[1,2]}" ) == EXIT_FAILURE
+        || __check( to, "{\"a\":{\"b\":1}}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( from );
+    js_free( to );
+    js_free( snapshot );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    move_stats_t stats;
+    stats.count = 0;
+
+    move_stats_t other_stats;
+    other_stats.count = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    js_allocator_t other;
+    js_make_allocator_default( &__alloc, &__free, &other_stats, &other );
+
+    if( __test_relink( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_copy( allocator, allocator, js_flag_node_pool, js_flag_none ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_copy( allocator, allocator, js_flag_none, js_flag_node_pool ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_copy( allocator, other, js_flag_none, js_flag_none ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_refused( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( stats.count != 0 || other_stats.count != 0 )
+    {
+        printf( "move leaked allocations: %zu %zu\n", stats.count, other_stats.count );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
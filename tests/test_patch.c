@@ -0,0 +1,350 @@
+#include "json/json.h"
+#include "json/json_dump.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+typedef struct patch_stats_t
+{
+    js_size_t count;
+} patch_stats_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    patch_stats_t * stats = (patch_stats_t *)ud;
+
+    ++stats->count;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    patch_stats_t * stats = (patch_stats_t *)ud;
+
+    --stats->count;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __dump( const js_element_t * _element, char * _memory, js_size_t _capacity )
+{
+    js_buffer_t dump_buff;
+    js_make_buffer( _memory, _capacity, &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_dump( _element, &dump_ctx );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_patch( js_allocator_t _allocator, js_flags_t _flags, js_element_t * _base, const char * _patch, const char * _expected )
+{
+    js_element_t * patch;
+    if( js_parse( _allocator, _flags, _patch, strlen( _patch ) + 1, &__failed, JS_NULLPTR, &patch ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    char expected_memory[512];
+
+    js_element_t * total;
+    if( js_patch( _allocator, _flags, _base, patch, &total ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    __dump( total, expected_memory, sizeof( expected_memory ) );
+
+    js_free( total );
+
+    if( js_patch_inplace( _base, patch ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( patch );
+
+    char dump_memory[512];
+    __dump( _base, dump_memory, sizeof( dump_memory ) );
+
+    if( strcmp( dump_memory, _expected ) != 0 || strcmp( expected_memory, _expected ) != 0 )
+    {
+        printf( "patch mismatch:\n  inplace: %s\n  clone: %s\n  expected: %s\n", dump_memory, expected_memory, _expected );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_patch_flags( js_flags_t _flags )
+{
+    patch_stats_t stats;
+    stats.count = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    char json_base[] = "{\"a\":1,\"b\":{\"c\":2,\"d\":[1,2]},\"e\":\"x\",\"f\":true}";
+
+    js_element_t * base;
+    if( js_parse( allocator, _flags, json_base, sizeof( json_base ), &__failed, JS_NULLPTR, &base ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_patch( allocator, _flags, base
+        , "{\"a\":null,\"b\":{\"c\":null,\"d\":{\"z\":null,\"y\":3},\"n\":{\"m\":null,\"k\":1}},\"e\":[1],\"g\":{\"h\":null,\"i\":\"j\"},\"q\":null}"
+        , "{\"b\":{\"d\":{\"y\":3},\"n\":{\"k\":1}},\"e\":[1],\"f\":true,\"g\":{\"i\":\"j\"}}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_patch( allocator, _flags, base
+        , "{\"g\":null}"
+        , "{\"b\":{\"d\":{\"y\":3},\"n\":{\"k\":1}},\"e\":[1],\"f\":true}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_patch( allocator, _flags, base
+        , "{\"z\":2,\"b\":{\"n\":null,\"d\":null},\"e\":null,\"f\":null}"
+        , "{\"b\":{},\"z\":2}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_patch( allocator, _flags, base
+        , "{}"
+        , "{\"b\":{},\"z\":2}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_size_t size = js_object_size( base );
+
+    js_free( base );
+
+    if( size != 2 || stats.count != 0 )
+    {
+        printf( "patch size: %zu leaked allocations: %zu\n", size, stats.count );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_patch_large( void )
+{
+    patch_stats_t stats;
+    stats.count = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    js_element_t * base;
+    js_create( allocator, js_flag_node_pool, &base );
+
+    js_element_t * patch;
+    js_create( allocator, js_flag_node_pool, &patch );
+
+    for( int index = 0; index != 5000; ++index )
+    {
+        char key[16];
+        int key_size = sprintf( key, "k%d", index );
+
+        js_string_t key_string = {key, (js_size_t)key_size};
+        js_object_add_field_integer( base, base, key_string, index );
+    }
+
+    for( int index = 0; index != 500; ++index )
+    {
+        char key[16];
+        int key_size = sprintf( key, "k%d", index * 10 );
+
+        js_string_t key_string = {key, (js_size_t)key_size};
+
+        if( index % 2 == 0 )
+        {
+            js_object_add_field_null( patch, patch, key_string );
+        }
+        else
+        {
+            js_object_add_field_integer( patch, patch, key_string, -index );
+        }
+
+        key_size = sprintf( key, "n%d", index );
+
+        js_string_t new_key_string = {key, (js_size_t)key_size};
+        js_object_add_field_integer( patch, patch, new_key_string, index );
+    }
+
+    if( js_patch_inplace( base, patch ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( patch );
+
+    int test = js_object_size( base ) == 5000 - 250 + 500 ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    for( int index = 0; index != 5000 && test == EXIT_SUCCESS; ++index )
+    {
+        char key[16];
+        sprintf( key, "k%d", index );
+
+        const js_element_t * value = js_object_get( base, key );
+
+        if( index % 20 == 0 )
+        {
+            test = value == JS_NULLPTR ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        else if( index % 10 == 0 )
+        {
+            test = value != JS_NULLPTR && js_get_integer( value ) == -index / 10 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        else
+        {
+            test = value != JS_NULLPTR && js_get_integer( value ) == index ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    const js_element_t * last = js_object_get( base, "n499" );
+
+    if( last == JS_NULLPTR || js_get_integer( last ) != 499 )
+    {
+        test = EXIT_FAILURE;
+    }
+
+    js_free( base );
+
+    if( test == EXIT_FAILURE || stats.count != 0 )
+    {
+        printf( "patch large failed, leaked allocations: %zu\n", stats.count );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_diff( const char * _base, const char * _total, const char * _expected, const char * _patched )
+{
+    patch_stats_t stats;
+    stats.count = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    js_element_t * base;
+    if( js_parse( allocator, js_flag_none, _base, strlen( _base ) + 1, &__failed, JS_NULLPTR, &base ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * total;
+    if( js_parse( allocator, js_flag_none, _total, strlen( _total ) + 1, &__failed, JS_NULLPTR, &total ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * diff;
+    if( js_diff( allocator, js_flag_node_pool, base, total, &diff ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    char diff_memory[512];
+    __dump( diff, diff_memory, sizeof( diff_memory ) );
+
+    if( js_patch_inplace( base, diff ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    char base_memory[512];
+    __dump( base, base_memory, sizeof( base_memory ) );
+
+    js_free( base );
+    js_free( total );
+    js_free( diff );
+
+    if( strcmp( diff_memory, _expected ) != 0 || strcmp( base_memory, _patched ) != 0 || stats.count != 0 )
+    {
+        printf( "diff mismatch:\n  diff: %s\n  expected: %s\n  patched: %s\n  expected: %s\n", diff_memory, _expected, base_memory, _patched );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    if( __test_patch_flags( js_flag_none ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_patch_flags( js_flag_node_pool ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_patch_large() == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_diff( "{\"a\":1,\"b\":{\"c\":2,\"d\":[1,2]},\"e\":\"x\",\"f\":{\"g\":true}}"
+        , "{\"b\":{\"c\":3,\"d\":[1,2]},\"e\":\"x\",\"f\":{\"g\":true},\"h\":[null]}"
+        , "{\"a\":null,\"b\":{\"c\":3},\"h\":[null]}"
+        , "{\"b\":{\"c\":3,\"d\":[1,2]},\"e\":\"x\",\"f\":{\"g\":true},\"h\":[null]}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_diff( "{\"a\":[1,{\"b\":2.5}],\"c\":{\"d\":\"e\",\"f\":1}}"
+        , "{\"c\":{\"f\":1,\"d\":\"e\"},\"a\":[1,{\"b\":2.5}]}"
+        , "{}"
+        , "{\"a\":[1,{\"b\":2.5}],\"c\":{\"d\":\"e\",\"f\":1}}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_diff( "{\"a\":{\"b\":1},\"c\":[1],\"d\":{}}"
+        , "{\"a\":2,\"c\":{\"x\":[]},\"d\":{\"y\":{\"z\":false}}}"
+        , "{\"a\":2,\"c\":{\"x\":[]},\"d\":{\"y\":{\"z\":false}}}"
+        , "{\"a\":2,\"c\":{\"x\":[]},\"d\":{\"y\":{\"z\":false}}}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_diff( "{\"a\":1,\"b\":2,\"d\":{}}"
+        , "{\"a\":1,\"b\":null,\"c\":null,\"d\":{\"e\":null}}"
+        , "{\"b\":null,\"d\":{\"e\":null},\"c\":null}"
+        , "{\"a\":1,\"d\":{}}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
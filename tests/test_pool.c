@@ -0,0 +1,334 @@
+#include "json/json.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+
+typedef CRITICAL_SECTION pool_mutex_t;
+typedef HANDLE pool_thread_t;
+
+#define POOL_MUTEX_INIT( M ) InitializeCriticalSection( M )
+#define POOL_MUTEX_DESTROY( M ) DeleteCriticalSection( M )
+#define POOL_MUTEX_LOCK( M ) EnterCriticalSection( M )
+#define POOL_MUTEX_UNLOCK( M ) LeaveCriticalSection( M )
+#else
+#include <pthread.h>
+
+typedef pthread_mutex_t pool_mutex_t;
+typedef pthread_t pool_thread_t;
+
+#define POOL_MUTEX_INIT( M ) pthread_mutex_init( M, NULL )
+#define POOL_MUTEX_DESTROY( M ) pthread_mutex_destroy( M )
+#define POOL_MUTEX_LOCK( M ) pthread_mutex_lock( M )
+#define POOL_MUTEX_UNLOCK( M ) pthread_mutex_unlock( M )
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+typedef struct pool_stats_t
+{
+    pool_mutex_t mutex;
+    js_size_t count;
+    js_size_t allocs;
+} pool_stats_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    pool_stats_t * stats = (pool_stats_t *)ud;
+
+    POOL_MUTEX_LOCK( &stats->mutex );
+
+    ++stats->count;
+    ++stats->allocs;
+
+    POOL_MUTEX_UNLOCK( &stats->mutex );
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    pool_stats_t * stats = (pool_stats_t *)ud;
+
+    POOL_MUTEX_LOCK( &stats->mutex );
+
+    --stats->count;
+
+    POOL_MUTEX_UNLOCK( &stats->mutex );
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_recycle( js_allocator_t _allocator, pool_stats_t * _stats )
+{
+    js_document_pool_t * pool;
+    if( js_document_pool_create( _allocator, js_flag_none, &pool ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    const char * message = "{\"a\":[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,64,65,66,67,68,69,70]}";
+
+    js_element_t * documents[6];
+
+    for( js_size_t index = 0; index != 6; ++index )
+    {
+        if( js_document_pool_acquire( pool, documents + index ) == JS_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+
+        if( js_parse_into( documents[index], message, strlen( message ) + 1, &__failed, JS_NULLPTR ) == JS_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    for( js_size_t index = 0; index != 6; ++index )
+    {
+        js_document_pool_release( pool, documents[index] );
+    }
+
+    _stats->allocs = 0;
+
+    for( js_size_t index = 0; index != 6; ++index )
+    {
+        if( js_document_pool_acquire( pool, documents + index ) == JS_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+
+        if( js_parse_into( documents[index], message, strlen( message ) + 1, &__failed, JS_NULLPTR ) == JS_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    for( js_size_t index = 0; index != 6; ++index )
+    {
+        js_document_pool_release( pool, documents[index] );
+    }
+
+    // one key string and one array per message, the nodes come from the recycled blocks
+    if( _stats->allocs != 6 * 2 )
+    {
+        printf( "pool recycled documents allocated %zu times\n", _stats->allocs );
+
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * warm[8];
+
+    for( js_size_t index = 0; index != 8; ++index )
+    {
+        if( js_document_pool_acquire( pool, warm + index ) == JS_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    _stats->allocs = 0;
+
+    if( js_parse_into( warm[7], message, strlen( message ) + 1, &__failed, JS_NULLPTR ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( _stats->allocs != 2 )
+    {
+        printf( "pool new document was not warmed up: %zu allocations\n", _stats->allocs );
+
+        return EXIT_FAILURE;
+    }
+
+    for( js_size_t index = 0; index != 8; ++index )
+    {
+        js_document_pool_release( pool, warm[index] );
+    }
+
+    js_document_pool_destroy( pool );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+typedef struct pool_worker_t
+{
+    js_document_pool_t * pool;
+    js_bool_t flush;
+    js_bool_t failed;
+} pool_worker_t;
+//////////////////////////////////////////////////////////////////////////
+static void __worker( pool_worker_t * _worker )
+{
+    pool_worker_t * worker = _worker;
+
+    const char * message = "{\"id\":1,\"list\":[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,64,65,66,67,68,69,70],\"name\":\"worker\"}";
+
+    for( js_size_t iteration = 0; iteration != 2000; ++iteration )
+    {
+        js_element_t * documents[6];
+
+        js_size_t count = 1 + iteration % 6;
+
+        for( js_size_t index = 0; index != count; ++index )
+        {
+            if( js_document_pool_acquire( worker->pool, documents + index ) == JS_FAILURE )
+            {
+                worker->failed = JS_TRUE;
+
+                return;
+            }
+
+            if( js_parse_into( documents[index], message, strlen( message ) + 1, &__failed, JS_NULLPTR ) == JS_FAILURE
+                || js_object_size( documents[index] ) != 3 || js_array_size( js_object_get( documents[index], "list" ) ) != 70 )
+            {
+                worker->failed = JS_TRUE;
+
+                return;
+            }
+        }
+
+        for( js_size_t index = 0; index != count; ++index )
+        {
+            js_document_pool_release( worker->pool, documents[index] );
+        }
+    }
+
+    if( worker->flush == JS_TRUE )
+    {
+        js_document_pool_flush( worker->pool );
+    }
+}
+//////////////////////////////////////////////////////////////////////////
+#if defined(_WIN32)
+static DWORD WINAPI __worker_thread( LPVOID _ud )
+{
+    __worker( (pool_worker_t *)_ud );
+
+    return 0;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __thread_create( pool_thread_t * _thread, pool_worker_t * _worker )
+{
+    *_thread = CreateThread( NULL, 0, &__worker_thread, _worker, 0, NULL );
+
+    return *_thread != NULL ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __thread_join( pool_thread_t _thread )
+{
+    WaitForSingleObject( _thread, INFINITE );
+    CloseHandle( _thread );
+}
+#else
+static void * __worker_thread( void * _ud )
+{
+    __worker( (pool_worker_t *)_ud );
+
+    return NULL;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __thread_create( pool_thread_t * _thread, pool_worker_t * _worker )
+{
+    return pthread_create( _thread, NULL, &__worker_thread, _worker ) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __thread_join( pool_thread_t _thread )
+{
+    pthread_join( _thread, NULL );
+}
+#endif
+//////////////////////////////////////////////////////////////////////////
+static int __test_threads( js_allocator_t _allocator )
+{
+    js_document_pool_t * pool;
+    if( js_document_pool_create( _allocator, js_flag_none, &pool ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    pool_thread_t threads[4];
+    pool_worker_t workers[4];
+
+    for( js_size_t index = 0; index != 4; ++index )
+    {
+        pool_worker_t * worker = workers + index;
+
+        worker->pool = pool;
+        worker->flush = (index % 2 == 0) ? JS_TRUE : JS_FALSE;
+        worker->failed = JS_FALSE;
+
+        if( __thread_create( threads + index, worker ) == EXIT_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    for( js_size_t index = 0; index != 4; ++index )
+    {
+        __thread_join( threads[index] );
+    }
+
+    // workers that did not flush leave documents in their slots, destroy still frees them
+    js_document_pool_destroy( pool );
+
+    for( js_size_t index = 0; index != 4; ++index )
+    {
+        if( workers[index].failed == JS_TRUE )
+        {
+            printf( "pool worker %zu failed\n", index );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    pool_stats_t stats;
+    POOL_MUTEX_INIT( &stats.mutex );
+    stats.count = 0;
+    stats.allocs = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    if( __test_recycle( allocator, &stats ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_threads( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( stats.count != 0 )
+    {
+        printf( "pool leaked allocations: %zu\n", stats.count );
+
+        return EXIT_FAILURE;
+    }
+
+    POOL_MUTEX_DESTROY( &stats.mutex );
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
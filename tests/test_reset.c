@@ -0,0 +1,213 @@
+#include "json/json.h"
+#include "json/json_dump.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+typedef struct reset_stats_t
+{
+    js_size_t count;
+    js_size_t allocs;
+} reset_stats_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    reset_stats_t * stats = (reset_stats_t *)ud;
+
+    ++stats->count;
+    ++stats->allocs;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    reset_stats_t * stats = (reset_stats_t *)ud;
+
+    --stats->count;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __check( const js_element_t * _element, const char * _expected )
+{
+    char dump_memory[4096];
+
+    js_buffer_t dump_buff;
+    js_make_buffer( dump_memory, sizeof( dump_memory ), &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_dump( _element, &dump_ctx );
+
+    if( strcmp( dump_memory, _expected ) != 0 )
+    {
+        printf( "reset mismatch:\n  dump: %s\n  expected: %s\n", dump_memory, _expected );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_element_t * __parse( js_allocator_t _allocator, js_flags_t _flags, const char * _data )
+{
+    js_element_t * element;
+    if( js_parse( _allocator, _flags, _data, strlen( _data ) + 1, &__failed, JS_NULLPTR, &element ) == JS_FAILURE )
+    {
+        return JS_NULLPTR;
+    }
+
+    return element;
+}
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+static void __make_message( char * _buffer, js_size_t _fields, int _seed )
+{
+    char * it = _buffer;
+
+    *it++ = '{';
+
+    for( js_size_t index = 0; index != _fields; ++index )
+    {
+        it += sprintf( it, "%s\"f%03zu\":[%d,true]", index == 0 ? "" : ",", index, (int)((index + _seed) % 100) );
+    }
+
+    *it++ = '}';
+    *it = '\0';
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_pool( js_allocator_t _allocator, reset_stats_t * _stats )
+{
+    char message[4096];
+    __make_message( message, 100, 0 );
+
+    js_element_t * document = __parse( _allocator, js_flag_node_pool, message );
+
+    js_size_t first_allocs = _stats->allocs;
+
+    for( int seed = 1; seed != 4; ++seed )
+    {
+        __make_message( message, 100, seed );
+
+        _stats->allocs = 0;
+
+        if( js_parse_into( document, message, strlen( message ) + 1, &__failed, JS_NULLPTR ) == JS_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+
+        if( __check( document, message ) == EXIT_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+
+        if( _stats->allocs + 4 >= first_allocs )
+        {
+            printf( "reset did not reuse node blocks: %zu of %zu allocations\n", _stats->allocs, first_allocs );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    js_reset( document );
+
+    if( js_object_size( document ) != 0 || __check( document, "{}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( document );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_compact( js_allocator_t _allocator, reset_stats_t * _stats )
+{
+    char message[4096];
+    __make_message( message, 100, 0 );
+
+    js_element_t * base = __parse( _allocator, js_flag_none, message );
+
+    js_element_t * document;
+    if( js_clone( _allocator, js_flag_compact, base, &document ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( base );
+
+    for( int seed = 1; seed != 4; ++seed )
+    {
+        __make_message( message, 100, seed );
+
+        _stats->allocs = 0;
+
+        if( js_parse_into( document, message, strlen( message ) + 1, &__failed, JS_NULLPTR ) == JS_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+
+        if( _stats->allocs != 0 )
+        {
+            printf( "reset compact parse allocated %zu times\n", _stats->allocs );
+
+            return EXIT_FAILURE;
+        }
+
+        if( __check( document, message ) == EXIT_FAILURE )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    js_free( document );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    reset_stats_t stats;
+    stats.count = 0;
+    stats.allocs = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    if( __test_pool( allocator, &stats ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_compact( allocator, &stats ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( stats.count != 0 )
+    {
+        printf( "reset leaked allocations: %zu\n", stats.count );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include "json/json.h"
+#include "json/json_dump.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+typedef struct share_stats_t
+{
+    js_size_t count;
+} share_stats_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    share_stats_t * stats = (share_stats_t *)ud;
+
+    ++stats->count;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    share_stats_t * stats = (share_stats_t *)ud;
+
+    --stats->count;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __check( const js_element_t * _element, const char * _expected )
+{
+    char dump_memory[512];
+
+    js_buffer_t dump_buff;
+    js_make_buffer( dump_memory, sizeof( dump_memory ), &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_dump( _element, &dump_ctx );
+
+    if( strcmp( dump_memory, _expected ) != 0 )
+    {
+        printf( "share mismatch:\n  dump: %s\n  expected: %s\n", dump_memory, _expected );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_element_t * __parse( js_allocator_t _allocator, js_flags_t _flags, const char * _data )
+{
+    js_element_t * element;
+    if( js_parse( _allocator, _flags, _data, strlen( _data ) + 1, &__failed, JS_NULLPTR, &element ) == JS_FAILURE )
+    {
+        return JS_NULLPTR;
+    }
+
+    return element;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_snapshot( js_allocator_t _allocator )
+{
+    const char * json_base = "{\"config\":{\"name\":\"a\",\"list\":[1,2]},\"state\":{\"deep\":{\"x\":1}},\"big\":[[1],[2]]}";
+
+    js_element_t * state = __parse( _allocator, js_flag_shared, json_base );
+
+    js_element_t * snapshot;
+    if( js_clone( _allocator, js_flag_shared, state, &snapshot ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( js_object_get( state, "config" ) != js_object_get( snapshot, "config" ) || js_object_get( state, "big" ) != js_object_get( snapshot, "big" ) )
+    {
+        printf( "share clone did not share containers\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * patch = __parse( _allocator, js_flag_shared, "{\"config\":{\"name\":\"b\"},\"state\":{\"deep\":{\"y\":2}}}" );
+
+    if( js_patch_inplace( state, patch ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( patch );
+
+    if( js_object_get( state, "big" ) != js_object_get( snapshot, "big" )
+        || js_object_get( js_object_get( state, "config" ), "list" ) != js_object_get( js_object_get( snapshot, "config" ), "list" ) )
+    {
+        printf( "share patch copied untouched subtrees\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * list = js_object_get( js_object_get( state, "config" ), "list" );
+
+    if( js_array_push_integer( state, list, 3 ) == JS_SUCCESSFUL )
+    {
+        printf( "share write into a shared container was not refused\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    list = js_object_edit( state, js_object_edit( state, state, "config" ), "list" );
+
+    if( list == JS_NULLPTR || js_array_push_integer( state, list, 3 ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * big = js_array_edit( state, js_object_edit( state, state, "big" ), 1 );
+
+    if( big == JS_NULLPTR || js_array_push_integer( state, big, 4 ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __check( state, "{\"config\":{\"name\":\"b\",\"list\":[1,2,3]},\"state\":{\"deep\":{\"x\":1,\"y\":2}},\"big\":[[1],[2,4]]}" ) == EXIT_FAILURE
+        || __check( snapshot, json_base ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * version;
+    js_element_t * version_patch = __parse( _allocator, js_flag_shared, "{\"big\":null}" );
+
+    if( js_patch( _allocator, js_flag_shared, state, version_patch, &version ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( version_patch );
+
+    if( js_object_get( version, "config" ) != js_object_get( state, "config" ) )
+    {
+        printf( "share patch did not share the base\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_free( state );
+
+    js_element_t * snapshot_list = js_object_edit( snapshot, js_object_edit( snapshot, snapshot, "config" ), "list" );
+
+    if( snapshot_list == JS_NULLPTR || js_array_push_integer( snapshot, snapshot_list, 5 ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __check( snapshot, "{\"config\":{\"name\":\"a\",\"list\":[1,2,5]},\"state\":{\"deep\":{\"x\":1}},\"big\":[[1],[2]]}" ) == EXIT_FAILURE
+        || __check( version, "{\"config\":{\"name\":\"b\",\"list\":[1,2,3]},\"state\":{\"deep\":{\"x\":1,\"y\":2}}}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( snapshot );
+    js_free( version );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_unshared( js_allocator_t _allocator )
+{
+    js_element_t * base = __parse( _allocator, js_flag_shared | js_flag_node_pool, "{\"a\":{\"b\":[1]}}" );
+
+    js_element_t * clone;
+    if( js_clone( _allocator, js_flag_shared | js_flag_node_pool, base, &clone ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    int test = js_object_get( base, "a" ) != js_object_get( clone, "a" ) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    js_free( base );
+    js_free( clone );
+
+    if( test == EXIT_FAILURE )
+    {
+        printf( "share node pool documents must not share\n" );
+    }
+
+    return test;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_detached( js_allocator_t _allocator )
+{
+    js_element_t * document = __parse( _allocator, js_flag_shared, "{\"a\":{\"b\":[1]},\"c\":1}" );
+
+    js_element_t * a = js_object_detach( document, document, "a" );
+
+    if( a == JS_NULLPTR || js_array_push_integer( document, js_object_get( a, "b" ), 2 ) == JS_FAILURE )
+    {
+        printf( "share detached subtree was not writable\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_string_t key = {"d", 1};
+
+    if( js_object_attach( document, document, key, document, a ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __check( document, "{\"c\":1,\"d\":{\"b\":[1,2]}}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( document );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_released( js_allocator_t _allocator )
+{
+    js_element_t * a = __parse( _allocator, js_flag_shared, "{\"x\":{\"y\":[1,2]}}" );
+
+    js_element_t * b;
+    if( js_clone( _allocator, js_flag_shared, a, &b ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( js_object_edit( b, b, "x" ) == JS_NULLPTR )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * c;
+    if( js_clone( _allocator, js_flag_shared, a, &c ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( b );
+
+    js_hash_t hash = js_hash( a );
+
+    js_element_t * y = js_object_get( js_object_get( a, "x" ), "y" );
+
+    if( js_array_push_integer( a, y, 3 ) == JS_SUCCESSFUL )
+    {
+        printf( "share write through a released copy was not refused\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    y = js_object_edit( a, js_object_edit( a, a, "x" ), "y" );
+
+    if( y == JS_NULLPTR || js_array_push_integer( a, y, 3 ) == JS_FAILURE || js_hash( a ) == hash )
+    {
+        printf( "share edit did not relink a released copy\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    if( __check( a, "{\"x\":{\"y\":[1,2,3]}}" ) == EXIT_FAILURE
+        || __check( c, "{\"x\":{\"y\":[1,2]}}" ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_free( a );
+    js_free( c );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    share_stats_t stats;
+    stats.count = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    if( __test_snapshot( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_unshared( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_detached( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_released( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( stats.count != 0 )
+    {
+        printf( "share leaked allocations: %zu\n", stats.count );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
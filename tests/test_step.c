@@ -0,0 +1,236 @@
+#include "json/json.h"
+#include "json/json_dump.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+typedef struct step_stats_t
+{
+    js_size_t count;
+} step_stats_t;
+//////////////////////////////////////////////////////////////////////////
+static void * __alloc( js_size_t size, void * ud )
+{
+    step_stats_t * stats = (step_stats_t *)ud;
+
+    ++stats->count;
+
+    void * p = malloc( size );
+
+    return p;
+}
+//////////////////////////////////////////////////////////////////////////
+static void __free( void * ptr, void * ud )
+{
+    step_stats_t * stats = (step_stats_t *)ud;
+
+    --stats->count;
+
+    free( ptr );
+}
+//////////////////////////////////////////////////////////////////////////
+static void __failed( const char * _data, const char * _end, const char * _message, void * _ud )
+{
+    (void)_data;
+    (void)_end;
+    (void)_ud;
+
+    printf( "failed: %s\n", _message );
+}
+//////////////////////////////////////////////////////////////////////////
+static int __check( const js_element_t * _element, const char * _expected )
+{
+    static char dump_memory[65536];
+
+    js_buffer_t dump_buff;
+    js_make_buffer( dump_memory, sizeof( dump_memory ), &dump_buff );
+
+    js_dump_ctx_t dump_ctx;
+    js_make_dump_ctx_buffer( &dump_buff, &dump_ctx );
+
+    js_dump( _element, &dump_ctx );
+
+    if( strcmp( dump_memory, _expected ) != 0 )
+    {
+        printf( "step mismatch:\n  dump: %s\n  expected: %s\n", dump_memory, _expected );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static js_element_t * __parse( js_allocator_t _allocator, js_flags_t _flags, const char * _data )
+{
+    js_element_t * element;
+    if( js_parse( _allocator, _flags, _data, strlen( _data ) + 1, &__failed, JS_NULLPTR, &element ) == JS_FAILURE )
+    {
+        return JS_NULLPTR;
+    }
+
+    return element;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_step( js_allocator_t _allocator, js_flags_t _flags, const char * _data, js_size_t _budget )
+{
+    js_parser_t * parser;
+    if( js_parser_create( _allocator, _flags, _data, strlen( _data ) + 1, &__failed, JS_NULLPTR, &parser ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_size_t calls = 0;
+
+    js_parse_status_t status;
+
+    do
+    {
+        status = js_parse_step( parser, _budget );
+
+        ++calls;
+    }
+    while( status == js_parse_status_progress );
+
+    js_element_t * document = js_parser_document( parser );
+
+    js_parser_destroy( parser );
+
+    if( status != js_parse_status_done )
+    {
+        printf( "step parse failed\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    js_element_t * expected = __parse( _allocator, _flags, _data );
+
+    if( js_equal( _allocator, document, expected ) == JS_FALSE || __check( document, _data ) == EXIT_FAILURE )
+    {
+        printf( "step parse differs from js_parse\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    if( _flags & js_flag_source_span )
+    {
+        js_string_t source;
+        js_string_t expected_source;
+
+        if( js_get_source( js_object_get( document, "b" ), &source ) == JS_FALSE
+            || js_get_source( js_object_get( expected, "b" ), &expected_source ) == JS_FALSE
+            || source.value != expected_source.value || source.size != expected_source.size )
+        {
+            printf( "step parse source span mismatch\n" );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    js_free( expected );
+    js_free( document );
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_deep( js_allocator_t _allocator )
+{
+    static char data[4096];
+
+    char * it = data;
+
+    it += sprintf( it, "{\"b\":" );
+
+    for( int index = 0; index != 100; ++index )
+    {
+        it += sprintf( it, "[%d,", index );
+    }
+
+    it += sprintf( it, "{}" );
+
+    for( int index = 0; index != 100; ++index )
+    {
+        *it++ = ']';
+    }
+
+    *it++ = '}';
+    *it = '\0';
+
+    int test = __test_step( _allocator, js_flag_node_pool, data, 7 );
+
+    return test;
+}
+//////////////////////////////////////////////////////////////////////////
+static int __test_failed( js_allocator_t _allocator )
+{
+    const char * data = "{\"a\":[1,2 3]}";
+
+    js_parser_t * parser;
+    if( js_parser_create( _allocator, js_flag_none, data, strlen( data ) + 1, &__failed, JS_NULLPTR, &parser ) == JS_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    js_parse_status_t status = js_parse_step( parser, 100 );
+
+    js_free( js_parser_document( parser ) );
+    js_parser_destroy( parser );
+
+    if( status != js_parse_status_failed )
+    {
+        printf( "step parse accepted a malformed array\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+//////////////////////////////////////////////////////////////////////////
+int main( int argc, char * argv[] )
+{
+    (void)argc;
+    (void)argv;
+
+    step_stats_t stats;
+    stats.count = 0;
+
+    js_allocator_t allocator;
+    js_make_allocator_default( &__alloc, &__free, &stats, &allocator );
+
+    const char * json_data = "{\"a\":1,\"b\":{\"c\":[true,false,null,\"s\",100000,0.25,[],{}],\"d\":{\"e\":[[1],[2,{\"f\":-3}]]}},\"g\":\"h\"}";
+
+    if( __test_step( allocator, js_flag_none, json_data, 1 ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_step( allocator, js_flag_source_span | js_flag_string_inplace, json_data, 3 ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_step( allocator, js_flag_arena, json_data, 1000 ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_deep( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( __test_failed( allocator ) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( stats.count != 0 )
+    {
+        printf( "step leaked allocations: %zu\n", stats.count );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file